@@ -0,0 +1,54 @@
+/**
+ * Times World::advance(n) against n calls to World::step() on random soups, from grids that stay in the
+ * last level cache to grids several times bigger than it, toroidal and bounded. Temporal blocking only
+ * starts past temporal_block_min_words, so the smallest size shows the plain per generation cost.
+ * The last column is 1 when advancing left the same cells as stepping.
+ *
+ * Run with the number of generations, i.e.
+ * ./Benchmark_advance 64
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.h"
+#include "grid.h"
+#include "world.h"
+
+int main(int argc, char *argv[]) {
+
+    const unsigned int generations = std::max((argc > 1) ? std::atoi(argv[1]) : 64, 1);
+    const unsigned int sizes[] = {1024, 4096, 8192, 16384};
+
+    std::cout << "size\tKiB\ttorus\tstep ms/gen\tadvance ms/gen\tspeedup\tsame" << std::endl;
+    for (const unsigned int size : sizes) {
+        const Grid soup = Benchmark::make_soup(size, size);
+        for (const bool toroidal : {true, false}) {
+            World stepped(soup);
+            World advanced(soup);
+            stepped.set_engine(StepEngine::VECTOR);
+            advanced.set_engine(StepEngine::VECTOR);
+
+            const double step_seconds = Benchmark::time_seconds([&]() {
+                for (unsigned int i = 0; i < generations; i++) {
+                    stepped.step(toroidal);
+                }
+            });
+            const double advance_seconds = Benchmark::time_seconds([&]() {
+                advanced.advance(generations, toroidal);
+            });
+
+            std::cout << size << "\t" << std::uint64_t(size) * size / 8 / 1024 << "\t" << toroidal << "\t"
+                      << 1000 * step_seconds / generations << "\t" << 1000 * advance_seconds / generations << "\t"
+                      << step_seconds / advance_seconds << "\t"
+                      << (stepped.get_state() == advanced.get_state()) << std::endl;
+        }
+    }
+
+    return 0;
+}
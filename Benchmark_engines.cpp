@@ -0,0 +1,53 @@
+/**
+ * Times the StepEngine::COUNT and StepEngine::TABLE engines of World::step on random soups of a few sizes,
+ * toroidal and bounded. The last column is 1 when the table engine agrees with counting.
+ *
+ * Run with the number of generations, i.e.
+ * ./Benchmark_engines 16
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.h"
+#include "grid.h"
+#include "world.h"
+
+int main(int argc, char *argv[]) {
+
+    const unsigned int generations = std::max((argc > 1) ? std::atoi(argv[1]) : 16, 1);
+    const unsigned int sizes[] = {256, 1024, 2048};
+
+    std::cout << "size\ttorus\tcount ms/gen\ttable ms/gen\tspeedup\tsame" << std::endl;
+    for (const unsigned int size : sizes) {
+        const Grid soup = Benchmark::make_soup(size, size);
+        for (const bool toroidal : {true, false}) {
+            World counted(soup);
+            World looked_up(soup);
+            counted.set_engine(StepEngine::COUNT);
+            looked_up.set_engine(StepEngine::TABLE);
+
+            const double count_seconds = Benchmark::time_seconds([&]() {
+                for (unsigned int i = 0; i < generations; i++) {
+                    counted.step(toroidal);
+                }
+            });
+            const double table_seconds = Benchmark::time_seconds([&]() {
+                for (unsigned int i = 0; i < generations; i++) {
+                    looked_up.step(toroidal);
+                }
+            });
+
+            std::cout << size << "\t" << toroidal << "\t"
+                      << 1000 * count_seconds / generations << "\t" << 1000 * table_seconds / generations << "\t"
+                      << count_seconds / table_seconds << "\t"
+                      << (counted.get_state() == looked_up.get_state()) << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * Times Grid operations on the Layout::ROW_MAJOR and Layout::TILED layouts across grid widths, with the
+ * number of cells fixed so only the shape changes. The column walk reads the 3x3 neighbourhood of every
+ * cell in a 64 cell wide strip from top to bottom, the access that a row major layout spreads a row apart.
+ * The last column is 1 when the tiled result converts back to the row major one.
+ *
+ * Run with the number of repeats of each operation, i.e.
+ * ./Benchmark_layout 4
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.h"
+#include "grid.h"
+
+// Count the alive cells in the 3x3 neighbourhood of every cell of a 64 cell wide strip, walking down the strip
+static std::uint64_t walk_column(const Grid &grid) {
+    const int x0 = grid.get_width() / 2;
+    std::uint64_t count = 0;
+    for (int y = 1; y + 1 < grid.get_height(); y++) {
+        for (int x = x0; x < x0 + 64; x++) {
+            for (int i = y - 1; i <= y + 1; i++) {
+                for (int j = x - 1; j <= x + 1; j++) {
+                    count += (grid.get(j, i) == Cell::ALIVE);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+int main(int argc, char *argv[]) {
+
+    const unsigned int repeats = std::max((argc > 1) ? std::atoi(argv[1]) : 4, 1);
+    const unsigned int cells = 1 << 26;
+    const unsigned int widths[] = {1024, 8192, 65536, 524288};
+    const char *names[] = {"transpose", "rotate", "crop", "walk"};
+    const Layout layouts[] = {Layout::ROW_MAJOR, Layout::TILED};
+
+    std::cout << "width\theight\top\trow major ms\ttiled ms\tspeedup\tsame" << std::endl;
+    for (const unsigned int width : widths) {
+        const unsigned int height = cells / width;
+        const Grid soup = Benchmark::make_soup(width, height);
+        for (unsigned int op = 0; op < 4; op++) {
+            double seconds[2];
+            Grid results[2];
+            std::uint64_t counts[2] = {0, 0};
+            for (unsigned int l = 0; l < 2; l++) {
+                const Grid grid = soup.to_layout(layouts[l]);
+                seconds[l] = Benchmark::time_seconds([&]() {
+                    for (unsigned int r = 0; r < repeats; r++) {
+                        if (op == 0) {
+                            results[l] = grid.transpose();
+                        }
+                        else if (op == 1) {
+                            results[l] = grid.rotate(1);
+                        }
+                        else if (op == 2) {
+                            results[l] = grid.crop(width / 4, height / 4, 3 * width / 4, 3 * height / 4);
+                        }
+                        else {
+                            counts[l] = walk_column(grid);
+                        }
+                    }
+                });
+            }
+            const bool same = (counts[0] == counts[1]) &&
+                              (results[0] == results[1].to_layout(Layout::ROW_MAJOR));
+
+            std::cout << width << "\t" << height << "\t" << names[op] << "\t"
+                      << 1000 * seconds[0] / repeats << "\t" << 1000 * seconds[1] / repeats << "\t"
+                      << seconds[0] / seconds[1] << "\t" << same << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -7,13 +7,20 @@
  * @date March, 2020
  */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Uses cxxopts from https://github.com/jarro2783/cxxopts under the MIT license
 #include "cxxopts/cxxopts.hxx"
 
 #include "grid.h"
+#include "hashlife.h"
+#include "range_world.h"
+#include "renderer.h"
+#include "rule.h"
+#include "step_kernels.h"
 #include "world.h"
 #include "zoo.h"
 
@@ -29,6 +36,14 @@ int main(int argc, char *argv[]) {
             ("s,steps","The number of steps to simulate the world.", cxxopts::value<int>()->default_value("10"))
             ("e,every","Print world to the console every N steps. 0 disables printing.", cxxopts::value<int>()->default_value("0"))
             ("t,toroidal", "Simulate the Game of Life on a torus.", cxxopts::value<bool>()->default_value("false"))
+            ("u,unbounded", "Simulate on a plane that grows as alive cells approach its edges.", cxxopts::value<bool>()->default_value("false"))
+            ("m,memory", "Stop an unbounded world growing past N MiB.", cxxopts::value<int>()->default_value("1024"))
+            ("b,block", "Print each KxK block of cells as one glyph by density.", cxxopts::value<int>()->default_value("1"))
+            ("v,viewport", "Only print the window x0,y0,x1,y1 of the world.", cxxopts::value<std::vector<int>>())
+            ("c,crop", "Only print the bounding box of the alive cells.", cxxopts::value<bool>()->default_value("false"))
+            ("n,engine", "Step with count, table, bitsliced, vector (widest AVX kernel on this CPU), or hashlife (unbounded plane).", cxxopts::value<std::string>()->default_value("vector"))
+            ("r,rule", "Step a Life-like rule such as B36/S23, a Generations rule such as B2/S/C3, or a Larger than Life rule such as R5,C0,M1,S34..58,B34..45,NM.", cxxopts::value<std::string>()->default_value("B3/S23"))
+            ("j,threads", "Step on N threads. 0 uses every hardware thread.", cxxopts::value<int>()->default_value("1"))
             ("h,help", "Print usage.");
 
     // Actually parse the command line arguments
@@ -44,6 +59,26 @@ int main(int argc, char *argv[]) {
     const int  steps    = result["steps"].as<int>();
     const int  every    = result["every"].as<int>();
     const bool toroidal = result["toroidal"].as<bool>();
+    const int  block    = result["block"].as<int>();
+    const int  threads  = result["threads"].as<int>();
+    const bool unbounded = result["unbounded"].as<bool>();
+    const int  memory   = result["memory"].as<int>();
+
+    // Frames are drawn into a reusable buffer and written to the console in one go
+    if (block < 1) {
+        std::cerr << "block must be at least 1." << std::endl;
+        std::exit(-1);
+    }
+    Renderer renderer(block);
+    renderer.set_crop_to_live(result["crop"].as<bool>());
+    if (result.count("viewport")) {
+        const std::vector<int> viewport = result["viewport"].as<std::vector<int>>();
+        if (viewport.size() != 4) {
+            std::cerr << "viewport must be x0,y0,x1,y1." << std::endl;
+            std::exit(-1);
+        }
+        renderer.set_viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
 
     // Start with an empty grid
     Grid grid;
@@ -59,29 +94,192 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    // Parse the rule, B3/S23 unless another was given
+    RangeRule range_rule;
+    try {
+        range_rule = RangeRule(result["rule"].as<std::string>());
+    }
+    catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        std::exit(-1);
+    }
+
+    // Larger than Life and Generations rules run on a RangeWorld, whatever the engine
+    if (range_rule.get_range() > 1 || range_rule.get_states() > 2 || range_rule.get_middle()) {
+        if (unbounded) {
+            std::cerr << "only Life-like rules can run on an unbounded world." << std::endl;
+            std::exit(-1);
+        }
+        RangeWorld range_world(grid);
+        range_world.set_rule(range_rule);
+        std::cout << "Engine range | Range " << range_rule.get_range() << " | States " << range_rule.get_states() << std::endl
+                  << "Initial state..." << std::endl
+                  << "Alive " << range_world.get_alive_cells() << std::endl;
+        renderer.write(std::cout, range_world.to_grid()) << std::endl;
+
+        for (int step = 0; step < steps; step++) {
+            range_world.step(toroidal);
+            if ((every > 0) && (step % every == 0)) {
+                std::cout << "Step " << (step + 1) << " of " << steps << std::endl;
+                renderer.write(std::cout, range_world.to_grid()) << std::endl;
+            }
+        }
+
+        std::cout << "Final state..." << std::endl
+                  << "Alive " << range_world.get_alive_cells() << std::endl;
+        renderer.write(std::cout, range_world.to_grid()) << std::endl;
+        if (result.count("output")) {
+            try {
+                Zoo::save_ascii(result["output"].as<std::string>(), range_world.to_grid());
+            }
+            catch (const std::exception &ex) {
+                std::cerr << ex.what() << std::endl;
+                std::exit(-1);
+            }
+        }
+        return 0;
+    }
+
+    // The rest are Life-like, run by World with kernels compiled for the common rules
+    std::uint16_t birth = 0;
+    std::uint16_t survival = 0;
+    for (unsigned int count = 0; count <= 8; count++) {
+        birth |= range_rule.is_birth(count) << count;
+        survival |= range_rule.is_survival(count) << count;
+    }
+    const Rule rule(birth, survival);
+
+    // HashLife runs the grid on an unbounded plane, jumping every N steps at once, with no edges to wrap
+    const std::string engine = result["engine"].as<std::string>();
+    if (engine == "hashlife") {
+        if (toroidal) {
+            std::cerr << "hashlife runs on an unbounded plane and cannot be toroidal." << std::endl;
+            std::exit(-1);
+        }
+        if (!rule.is_conway()) {
+            std::cerr << "hashlife only runs B3/S23." << std::endl;
+            std::exit(-1);
+        }
+        HashLife life(grid);
+        std::cout << "Engine hashlife" << std::endl
+                  << "Initial state..." << std::endl
+                  << "Alive " << life.get_alive_cells() << " | Generation " << life.get_generation() << std::endl;
+        renderer.write(std::cout, life.to_grid()) << std::endl;
+
+        // Jump straight to each printed step, on the same schedule as World below
+        for (int step = 0; step < steps;) {
+            const int next = (every > 0) ? std::min(steps, step + (every - step % every) % every + 1) : steps;
+            life.advance(next - step);
+            step = next;
+            if ((every > 0) && ((step - 1) % every == 0)) {
+                std::cout << "Step " << step << " of " << steps << std::endl;
+                renderer.write(std::cout, life.to_grid()) << std::endl;
+            }
+        }
+
+        std::cout << "Final state..." << std::endl
+                  << "Alive " << life.get_alive_cells() << " | Generation " << life.get_generation() << std::endl;
+        renderer.write(std::cout, life.to_grid()) << std::endl;
+        if (result.count("output")) {
+            try {
+                Zoo::save_ascii(result["output"].as<std::string>(), life.to_grid());
+            }
+            catch (const std::exception &ex) {
+                std::cerr << ex.what() << std::endl;
+                std::exit(-1);
+            }
+        }
+        return 0;
+    }
+
     // Construct a world from the parsed grid
     World world(grid);
 
+    // Pick the step engine, all engines produce the same cells
+    if (engine == "count") {
+        world.set_engine(StepEngine::COUNT);
+    }
+    else if (engine == "table") {
+        world.set_engine(StepEngine::TABLE);
+    }
+    else if (engine == "bitsliced") {
+        world.set_engine(StepEngine::BITSLICED);
+    }
+    else if (engine == "vector") {
+        world.set_engine(StepEngine::VECTOR);
+    }
+    else {
+        std::cerr << "engine must be count, table, bitsliced, vector, or hashlife." << std::endl;
+        std::exit(-1);
+    }
+
+    // Split each step across a persistent pool of threads, the cells are the same on any number
+    if (threads < 0) {
+        std::cerr << "threads must be at least 0." << std::endl;
+        std::exit(-1);
+    }
+    world.set_threads(threads);
+
+    // An unbounded world grows around its alive cells, up to the memory cap, and has no edges to wrap
+    if (unbounded) {
+        if (toroidal) {
+            std::cerr << "an unbounded world has no edges and cannot be toroidal." << std::endl;
+            std::exit(-1);
+        }
+        if (memory < 1) {
+            std::cerr << "memory must be at least 1." << std::endl;
+            std::exit(-1);
+        }
+        world.set_unbounded(true);
+        world.set_memory_cap(std::size_t(memory) << 20);
+    }
+
+    // Every engine runs any rule except B0, common rules have kernels compiled for them
+    try {
+        world.set_rule(rule);
+    }
+    catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        std::exit(-1);
+    }
+    std::cout << "Engine " << world.get_engine_name() << " | Threads " << world.get_threads()
+              << " | Rule " << rule.to_string() << (StepKernels::is_specialized(rule) ? "" : " (generic)") << std::endl;
+
     // Print the initial state of the grid
     std::cout << "Initial state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
+              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl;
+    renderer.write(std::cout, world.get_state()) << std::endl;
 
-    // Perform the requested number of update steps
-    for (int step = 0; step < steps; step++) {
-        world.step(toroidal);
+    // Perform the requested number of update steps, advancing in one go up to each printed step
+    for (int step = 0; step < steps;) {
+        const int next = (every > 0) ? std::min(steps, step + (every - step % every) % every + 1) : steps;
+        world.advance(next - step, toroidal);
+        step = next;
 
         // Print the state of the grid every N steps
-        if ((every > 0) && (step % every == 0)) {
-            std::cout << "Step " << (step + 1) << " of " << steps << std::endl
-                      << world.get_state() << std::endl;
+        if ((every > 0) && ((step - 1) % every == 0)) {
+            std::cout << "Step " << step << " of " << steps << std::endl;
+            renderer.write(std::cout, world.get_state()) << std::endl;
         }
     }
 
     // Print the final state of the grid
     std::cout << "Final state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
+              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl;
+    if (unbounded) {
+        std::cout << "Origin " << world.get_origin_x() << "," << world.get_origin_y()
+                  << " | Size " << world.get_width() << "x" << world.get_height()
+                  << (world.get_capped() ? " | Capped" : "") << std::endl;
+    }
+    renderer.write(std::cout, world.get_state()) << std::endl;
+
+    // Print how evenly the tiles of each step were spread over the threads
+    const std::vector<ThreadStats> thread_stats = world.get_thread_stats();
+    for (unsigned int t = 0; t < thread_stats.size(); t++) {
+        const ThreadStats &stats = thread_stats[t];
+        std::cout << "Thread " << t << " | Tiles " << stats.tasks << " | Stolen " << stats.stolen
+                  << " | Busy " << (stats.batch_ns ? 100 * stats.busy_ns / stats.batch_ns : 0) << "%" << std::endl;
+    }
 
     // Attempt to save to the output directory if a path was given
     if (result.count("output")) {
@@ -0,0 +1,303 @@
+/**
+ * Implements the allocators used for the packed cell buffers of Grid objects.
+ *      - A GridArena hands out word buffers aligned to a 64 byte cache line (and AVX-512 vector).
+ *      - Every Grid allocates from an arena, by default the shared one from GridArena::get_default().
+ *          - The default can be swapped for any other arena with GridArena::set_default(arena).
+ *
+ *      - A PoolArena keeps released buffers on free lists by power of two size class.
+ *          - The two buffers of a World and the temporaries made by crop and rotate are reused
+ *            instead of going back to malloc for every operation.
+ *          - The pool retains at most max_pooled_bytes of released buffers, anything past that
+ *            is freed straight away.
+ *          - Buffers whose size class is bigger than the whole pool could never be reused, so they
+ *            are allocated at exactly the requested size rather than rounded up to a power of two.
+ *          - Pools are safe to share between threads.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "arena.h"
+#include <cstdlib>
+#include <new>
+
+/**
+ * GridArena::~GridArena()
+ *
+ * Arenas are used polymorphically so they need a virtual destructor.
+ */
+GridArena::~GridArena()
+{
+}
+
+/**
+ * default_arena
+ *
+ * The arena used by grids that dont ask for a specific one, starts as a shared PoolArena.
+ */
+static GridArena *default_arena = nullptr;
+
+/**
+ * GridArena::get_default()
+ *
+ * Gets the arena new grids allocate from when no arena is given.
+ *
+ * @example
+ *
+ *      // Allocate a buffer of 16 words from the default arena
+ *      std::uint64_t *buffer = GridArena::get_default().allocate(16);
+ *      GridArena::get_default().deallocate(buffer, 16);
+ *
+ * @return
+ *      A reference to the default arena.
+ */
+GridArena &GridArena::get_default()
+{
+    //a function local static so the pool outlives every grid made after it
+    static PoolArena shared_pool;
+    if (default_arena == nullptr)
+    {
+        default_arena = &shared_pool;
+    }
+    return *default_arena;
+}
+
+/**
+ * GridArena::set_default(arena)
+ *
+ * Sets the arena new grids allocate from when no arena is given.
+ * Existing grids keep using the arena they were made with.
+ *
+ * @example
+ *
+ *      // Give every new grid a private pool
+ *      PoolArena pool;
+ *      GridArena::set_default(pool);
+ *
+ * @param arena
+ *      The arena to use, it must outlive every grid allocated from it.
+ */
+void GridArena::set_default(GridArena &arena)
+{
+    default_arena = &arena;
+}
+
+/**
+ * PoolArena::PoolArena(max_pooled_bytes)
+ *
+ * Construct an empty pool.
+ *
+ * @param max_pooled_bytes
+ *      Optional parameter. The most memory held on the free lists at once. Defaults to 256 MiB.
+ */
+PoolArena::PoolArena(const std::size_t max_pooled_bytes) : pooled_bytes(0), max_pooled_bytes(max_pooled_bytes)
+{
+}
+
+/**
+ * PoolArena::~PoolArena()
+ *
+ * Release every buffer still held on the free lists.
+ */
+PoolArena::~PoolArena()
+{
+    trim();
+}
+
+/**
+ * PoolArena::get_size_class(words)
+ *
+ * Private helper function to find the free list for a buffer size.
+ * Buffers are at least one cache line, and rounded up to a power of two words.
+ *
+ * @param words
+ *      The requested number of words.
+ *
+ * @return
+ *      The size class, a buffer in class c holds 2^c words.
+ */
+unsigned int PoolArena::get_size_class(const std::size_t words)
+{
+    unsigned int size_class = 0;
+    while ((std::size_t(1) << size_class) < words || (std::size_t(1) << size_class) < ALIGNMENT_WORDS)
+    {
+        size_class++;
+    }
+    return size_class;
+}
+
+/**
+ * PoolArena::is_pooled(size_class)
+ *
+ * Private helper function to check whether buffers of a size class can ever fit on the free lists.
+ *
+ * @param size_class
+ *      The size class, see PoolArena::get_size_class.
+ *
+ * @return
+ *      True if a buffer of the class is no bigger than max_pooled_bytes.
+ */
+bool PoolArena::is_pooled(const unsigned int size_class) const
+{
+    //compare in words so the largest classes dont overflow when scaled to bytes
+    return (std::size_t(1) << size_class) <= max_pooled_bytes / sizeof(std::uint64_t);
+}
+
+/**
+ * PoolArena::allocate(words)
+ *
+ * Hand out a 64 byte aligned buffer of at least the requested size, reusing a released buffer
+ * of the same size class if there is one. The contents of the buffer are not initialized.
+ * Buffers too big to ever be pooled are allocated at exactly the requested size.
+ *
+ * @param words
+ *      The number of std::uint64_t words needed.
+ *
+ * @return
+ *      A pointer to the buffer, or nullptr if no words were requested.
+ *
+ * @throws
+ *      std::bad_alloc if the memory cannot be allocated.
+ */
+std::uint64_t *PoolArena::allocate(const std::size_t words)
+{
+    if (words == 0)
+    {
+        return nullptr;
+    }
+
+    const unsigned int size_class = get_size_class(words);
+    if (!is_pooled(size_class))
+    {
+        return allocate_aligned(words);
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        std::vector<std::uint64_t *> &free_list = free_lists[size_class];
+        if (!free_list.empty())
+        {
+            std::uint64_t *buffer = free_list.back();
+            free_list.pop_back();
+            pooled_bytes -= (std::size_t(1) << size_class) * sizeof(std::uint64_t);
+            return buffer;
+        }
+    }
+    return allocate_aligned(std::size_t(1) << size_class);
+}
+
+/**
+ * PoolArena::deallocate(buffer, words)
+ *
+ * Return a buffer to the pool, or free it if the pool is already holding its maximum.
+ *
+ * @param buffer
+ *      A buffer handed out by this pool, or nullptr.
+ *
+ * @param words
+ *      The number of words the buffer was requested with.
+ */
+void PoolArena::deallocate(std::uint64_t *buffer, const std::size_t words)
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    const unsigned int size_class = get_size_class(words);
+    if (!is_pooled(size_class))
+    {
+        free_aligned(buffer);
+        return;
+    }
+    const std::size_t bytes = (std::size_t(1) << size_class) * sizeof(std::uint64_t);
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (pooled_bytes + bytes <= max_pooled_bytes)
+        {
+            free_lists[size_class].push_back(buffer);
+            pooled_bytes += bytes;
+            return;
+        }
+    }
+    free_aligned(buffer);
+}
+
+/**
+ * PoolArena::get_pooled_bytes()
+ *
+ * Gets how much released memory the pool is currently holding for reuse.
+ *
+ * @return
+ *      The number of bytes on the free lists.
+ */
+std::size_t PoolArena::get_pooled_bytes()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return pooled_bytes;
+}
+
+/**
+ * PoolArena::trim()
+ *
+ * Free every buffer held on the free lists, buffers still in use are unaffected.
+ */
+void PoolArena::trim()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    for (std::vector<std::uint64_t *> &free_list : free_lists)
+    {
+        for (std::uint64_t *buffer : free_list)
+        {
+            free_aligned(buffer);
+        }
+        free_list.clear();
+    }
+    pooled_bytes = 0;
+}
+
+/**
+ * PoolArena::allocate_aligned(words)
+ *
+ * Allocate a 64 byte aligned buffer straight from malloc. The pointer malloc returned is kept
+ * in the word just before the aligned buffer so free_aligned can give it back.
+ *
+ * @param words
+ *      The number of words needed.
+ *
+ * @return
+ *      A pointer to the aligned buffer.
+ *
+ * @throws
+ *      std::bad_alloc if the memory cannot be allocated.
+ */
+std::uint64_t *PoolArena::allocate_aligned(const std::size_t words)
+{
+    void *raw = std::malloc(words * sizeof(std::uint64_t) + ALIGNMENT + sizeof(void *));
+    if (raw == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    //leave room for the raw pointer then round up to the next cache line
+    const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *);
+    void **aligned = reinterpret_cast<void **>((start + ALIGNMENT - 1) & ~std::uintptr_t(ALIGNMENT - 1));
+    aligned[-1] = raw;
+    return reinterpret_cast<std::uint64_t *>(aligned);
+}
+
+/**
+ * PoolArena::free_aligned(buffer)
+ *
+ * Free a buffer made by PoolArena::allocate_aligned.
+ *
+ * @param buffer
+ *      The aligned buffer, or nullptr.
+ */
+void PoolArena::free_aligned(std::uint64_t *buffer)
+{
+    if (buffer != nullptr)
+    {
+        std::free(reinterpret_cast<void **>(buffer)[-1]);
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * Declares the allocators used for the packed cell buffers of Grid objects.
+ * Rich documentation for the api and behaviour of the arenas can be found in arena.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the classes.
+// #include ...
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Declare the interface of a GridArena, a pluggable source of cache line aligned word buffers.
+ */
+class GridArena
+{
+public:
+    static const std::size_t ALIGNMENT = 64;
+    static const std::size_t ALIGNMENT_WORDS = ALIGNMENT / sizeof(std::uint64_t);
+
+    virtual ~GridArena();
+
+    virtual std::uint64_t *allocate(const std::size_t words) = 0;
+    virtual void deallocate(std::uint64_t *buffer, const std::size_t words) = 0;
+
+    static GridArena &get_default();
+    static void set_default(GridArena &arena);
+};
+
+/**
+ * Declare the structure of a PoolArena, which keeps released buffers on free lists
+ * by power of two size class so they can be handed out again without hitting malloc.
+ * Buffers too big for the pool are allocated exactly and never pooled.
+ */
+class PoolArena : public GridArena
+{
+private:
+    std::vector<std::uint64_t *> free_lists[64];
+    std::size_t pooled_bytes;
+    std::size_t max_pooled_bytes;
+    std::mutex pool_mutex;
+
+    static unsigned int get_size_class(const std::size_t words);
+    bool is_pooled(const unsigned int size_class) const;
+
+public:
+    explicit PoolArena(const std::size_t max_pooled_bytes = std::size_t(256) << 20);
+    PoolArena(const PoolArena &other) = delete;
+    PoolArena &operator=(const PoolArena &other) = delete;
+    ~PoolArena();
+
+    std::uint64_t *allocate(const std::size_t words) override;
+    void deallocate(std::uint64_t *buffer, const std::size_t words) override;
+
+    std::size_t get_pooled_bytes();
+    void trim();
+
+    static std::uint64_t *allocate_aligned(const std::size_t words);
+    static void free_aligned(std::uint64_t *buffer);
+};
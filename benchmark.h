@@ -0,0 +1,68 @@
+/**
+ * Declares the helpers shared by the Benchmark_*.cpp programs, random soups to step and a wall clock timer.
+ * They are small and only used by the benchmarks, so they are defined here rather than in a library source.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the helpers.
+// #include ...
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include "grid.h"
+
+namespace Benchmark
+{
+
+/**
+ * Benchmark::make_soup(width, height)
+ *
+ * Fill a grid with a random soup a word at a time, about a quarter of the cells alive.
+ * The same size always gives the same soup, so runs can be compared.
+ *
+ * @param width
+ *      The width of the grid, a multiple of 64.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @return
+ *      The soup.
+ */
+inline Grid make_soup(const unsigned int width, const unsigned int height)
+{
+    std::mt19937_64 rng(width ^ (std::uint64_t(height) << 32));
+    Grid grid(width, height);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x += 64)
+        {
+            grid.set_word_unchecked(x, y, rng() & rng());
+        }
+    }
+    return grid;
+}
+
+/**
+ * Benchmark::time_seconds(function)
+ *
+ * Time one call of a function on the steady clock.
+ *
+ * @param function
+ *      The function to call with no arguments.
+ *
+ * @return
+ *      The seconds it took.
+ */
+template <typename Function>
+double time_seconds(Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}; // namespace Benchmark
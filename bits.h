@@ -0,0 +1,281 @@
+/**
+ * Declares the word level bit manipulation helpers shared by the packed cell containers.
+ * They are defined inline here, rather than in a translation unit, so they can be inlined into
+ * the hot loops of Grid, SparseGrid, and the step kernels.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the functions.
+// #include ...
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * count_bits(word)
+ *
+ * Count the set bits of a packed word, using the compiler popcount builtin where available
+ * and a SWAR (SIMD within a register) reduction otherwise.
+ *
+ * @return
+ *      The number of set bits (alive cells) in the word.
+ */
+inline unsigned int count_bits(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+/**
+ * read_bits(src, bit, count)
+ *
+ * Read count (1 to 64) consecutive bits starting at an arbitrary bit offset of a packed word array.
+ * Only the words actually holding the requested bits are touched.
+ *
+ * @return
+ *      The requested bits in the low bits of the result, the remaining high bits are 0.
+ */
+inline std::uint64_t read_bits(const std::uint64_t *src, const std::size_t bit, const unsigned int count)
+{
+    const std::size_t word = bit / 64;
+    const unsigned int shift = bit % 64;
+    std::uint64_t value = src[word] >> shift;
+    //pull the rest from the next word if the bits straddle a word boundary
+    if (shift + count > 64)
+    {
+        value |= src[word + 1] << (64 - shift);
+    }
+    if (count < 64)
+    {
+        value &= (std::uint64_t(1) << count) - 1;
+    }
+    return value;
+}
+
+/**
+ * copy_bits(dst, dst_bit, src, src_bit, count, alive_only)
+ *
+ * Copy count bits between two packed word arrays at arbitrary bit offsets, a word at a time.
+ * If alive_only is true the source bits are OR-ed in, so set bits are copied but clear bits are not.
+ *
+ * @return
+ *      The change in the number of set bits in the destination, so callers can keep their
+ *      alive cell counts up to date without a rescan.
+ */
+inline long long copy_bits(std::uint64_t *dst, std::size_t dst_bit,
+                          const std::uint64_t *src, std::size_t src_bit,
+                          std::size_t count, const bool alive_only = false)
+{
+    long long change = 0;
+    while (count > 0)
+    {
+        //fill up to the end of the current destination word
+        const unsigned int shift = dst_bit % 64;
+        const unsigned int chunk = (count < 64 - shift) ? count : 64 - shift;
+        const std::uint64_t mask = ((chunk == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << chunk) - 1)) << shift;
+        const std::uint64_t bits = read_bits(src, src_bit, chunk) << shift;
+
+        std::uint64_t &word = dst[dst_bit / 64];
+        change -= count_bits(word);
+        if (alive_only)
+        {
+            word |= bits;
+        }
+        else
+        {
+            word = (word & ~mask) | bits;
+        }
+        change += count_bits(word);
+
+        dst_bit += chunk;
+        src_bit += chunk;
+        count -= chunk;
+    }
+    return change;
+}
+
+/**
+ * combine_bits(dst, dst_bit, src, src_bit, count, op)
+ *
+ * Combine count bits of a packed word array into another at arbitrary bit offsets, a word at a time,
+ * replacing each destination word with op(destination, source). Bits outside the range are kept.
+ * When both offsets are word aligned the bulk of the range is a plain loop over whole words
+ * that the compiler can vectorize.
+ *
+ * @return
+ *      The change in the number of set bits in the destination.
+ */
+template <typename Op>
+inline long long combine_bits(std::uint64_t *dst, std::size_t dst_bit,
+                              const std::uint64_t *src, std::size_t src_bit,
+                              std::size_t count, Op op)
+{
+    long long change = 0;
+    if (dst_bit % 64 == 0 && src_bit % 64 == 0)
+    {
+        std::uint64_t *dst_words = dst + dst_bit / 64;
+        const std::uint64_t *src_words = src + src_bit / 64;
+        const std::size_t words = count / 64;
+        for (std::size_t i = 0; i < words; i++)
+        {
+            const std::uint64_t word = op(dst_words[i], src_words[i]);
+            change += (long long)count_bits(word) - count_bits(dst_words[i]);
+            dst_words[i] = word;
+        }
+        dst_bit += words * 64;
+        src_bit += words * 64;
+        count -= words * 64;
+    }
+    while (count > 0)
+    {
+        //fill up to the end of the current destination word
+        const unsigned int shift = dst_bit % 64;
+        const unsigned int chunk = (count < 64 - shift) ? count : 64 - shift;
+        const std::uint64_t mask = ((chunk == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << chunk) - 1)) << shift;
+        const std::uint64_t bits = read_bits(src, src_bit, chunk) << shift;
+
+        std::uint64_t &word = dst[dst_bit / 64];
+        const std::uint64_t combined = (word & ~mask) | (op(word, bits) & mask);
+        change += (long long)count_bits(combined) - count_bits(word);
+        word = combined;
+
+        dst_bit += chunk;
+        src_bit += chunk;
+        count -= chunk;
+    }
+    return change;
+}
+
+/**
+ * count_combined_bits(a, a_bit, b, b_bit, count, op)
+ *
+ * Count the set bits of op(a, b) over count bits of two packed word arrays at arbitrary bit offsets,
+ * a word at a time, without writing the combined bits anywhere.
+ * The op must map two clear bits to a clear bit, so the unused high bits of a chunk are not counted.
+ *
+ * @return
+ *      The number of set bits in the combination.
+ */
+template <typename Op>
+inline std::size_t count_combined_bits(const std::uint64_t *a, std::size_t a_bit,
+                                       const std::uint64_t *b, std::size_t b_bit,
+                                       std::size_t count, Op op)
+{
+    std::size_t total = 0;
+    while (count > 0)
+    {
+        const unsigned int chunk = (count < 64) ? count : 64;
+        total += count_bits(op(read_bits(a, a_bit, chunk), read_bits(b, b_bit, chunk)));
+        a_bit += chunk;
+        b_bit += chunk;
+        count -= chunk;
+    }
+    return total;
+}
+
+/**
+ * transpose_block(block)
+ *
+ * Transpose a 64x64 bit matrix in place, where bit c of block[r] is the cell in row r and column c.
+ * Swaps ever smaller sub-blocks across the diagonal (32x32, 16x16, ... 1x1) with masks and shifts,
+ * so the whole transpose takes 6 passes of 32 word operations rather than 4096 bit moves.
+ */
+inline void transpose_block(std::uint64_t block[64])
+{
+    std::uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (unsigned int size = 32; size != 0; size >>= 1, mask ^= (mask << size))
+    {
+        //visit the rows k that have bit size clear, pairing each with row k + size
+        for (unsigned int k = 0; k < 64; k = ((k | size) + 1) & ~size)
+        {
+            const std::uint64_t swap = ((block[k] >> size) ^ block[k | size]) & mask;
+            block[k] ^= swap << size;
+            block[k | size] ^= swap;
+        }
+    }
+}
+
+/**
+ * reverse_bits(word)
+ *
+ * Reverse the order of the bits in a word, mirroring 64 cells at once.
+ *
+ * @return
+ *      The word with bit i moved to bit 63 - i.
+ */
+inline std::uint64_t reverse_bits(std::uint64_t word)
+{
+    word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+    word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    word = ((word >> 8) & 0x00FF00FF00FF00FFULL) | ((word & 0x00FF00FF00FF00FFULL) << 8);
+    word = ((word >> 16) & 0x0000FFFF0000FFFFULL) | ((word & 0x0000FFFF0000FFFFULL) << 16);
+    return (word >> 32) | (word << 32);
+}
+
+/**
+ * lowest_bit(word)
+ *
+ * Find the lowest set bit of a non-zero word, using the compiler count trailing zeros builtin where
+ * available and a popcount of the bits below it otherwise.
+ *
+ * @return
+ *      The index, 0 to 63, of the lowest set bit. The result is undefined if the word is 0.
+ */
+inline unsigned int lowest_bit(const std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    return count_bits((word & (~word + 1)) - 1);
+#endif
+}
+
+/**
+ * highest_bit(word)
+ *
+ * Find the highest set bit of a non-zero word, using the compiler count leading zeros builtin where
+ * available and a popcount of the word smeared down from its highest bit otherwise.
+ *
+ * @return
+ *      The index, 0 to 63, of the highest set bit. The result is undefined if the word is 0.
+ */
+inline unsigned int highest_bit(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    word |= word >> 1;
+    word |= word >> 2;
+    word |= word >> 4;
+    word |= word >> 8;
+    word |= word >> 16;
+    word |= word >> 32;
+    return count_bits(word) - 1;
+#endif
+}
+
+/**
+ * mix_bits(word)
+ *
+ * Scramble a word so every input bit affects every output bit, the finalizer of the SplitMix64
+ * generator. Used to derive Zobrist keys from cell coordinates and to fold words into hashes.
+ *
+ * @return
+ *      The mixed word.
+ */
+inline std::uint64_t mix_bits(std::uint64_t word)
+{
+    word += 0x9E3779B97F4A7C15ULL;
+    word = (word ^ (word >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    word = (word ^ (word >> 27)) * 0x94D049BB133111EBULL;
+    return word ^ (word >> 31);
+}
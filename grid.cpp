@@ -3,10 +3,68 @@
  *      - New cells are initialized to Cell::DEAD.
  *      - Grids can be resized while retaining their contents in the remaining area.
  *      - Grids can be rotated, cropped, and merged together.
+ *          - Rotation is built from transposes and flips, all working on whole words.
+ *          - Transposes are cache blocked into 64x64 tiles, each tile is one word from each of 64 rows
+ *            and is transposed as a bit matrix entirely in registers.
+ *          - Square grids can be rotated in place, swapping tiles across the diagonal.
+ *          - Grids can be combined cell by cell with AND, OR, XOR, and AND-NOT (Grid::apply) a word at a time,
+ *            and the population of a combination counted without building it (Grid::count_cells).
  *      - Grids can return counts of the alive and dead cells.
- *      - Grids can be serialized directly to an ascii std::ostream.
- *
- * You are encouraged to use STL container types as an underlying storage mechanism for the grid cells.
+ *      - Grids can be serialized directly to an ascii std::ostream, a whole frame per write.
+ *
+ *      - Cells are stored bit-packed, 64 cells to a std::uint64_t word.
+ *          - Each row starts on a fresh word, cell x of a row is bit (x % 64) of word (x / 64).
+ *          - Bits past the width in the last word of a row are always kept 0 (dead), unless the
+ *            grid has a halo.
+ *          - Modifiable access goes through a Grid::CellReference proxy to the word and bit.
+ *
+ *      - Grids can optionally be constructed with a ghost border (halo) of up to 64 cells.
+ *          - Halo cells sit outside [0, width) by [0, height) and can be read with negative or
+ *            past the end coordinates through the unchecked access tier.
+ *          - Each row gets one guard word to its left, so cell 0 stays at bit 0 of its row.
+ *          - Grid::refresh_halo fills the halo with dead cells or with a toroidal copy of the
+ *            opposite edges, letting kernels read a 3x3 neighbourhood without any edge branches.
+ *          - Writes never touch the halo, it is stale until the next refresh.
+ *
+ *      - Cell buffers come from a pluggable GridArena, by default a shared PoolArena.
+ *          - Buffers and the start of every row are aligned to a 64 byte cache line, the row
+ *            stride is padded to a whole number of cache lines (one AVX-512 vector each).
+ *          - With a halo the left guard is a whole cache line, so cell 0 stays aligned.
+ *          - Buffers are zeroed in a single pass and released buffers are pooled for reuse.
+ *
+ *      - Grids can instead be constructed with Layout::TILED, storing each 64x64 tile of cells as 64
+ *        consecutive words (8 cache lines) so the rows above and below a word sit right next to it.
+ *          - Cell access, counts, crop, merge, rotate, and transpose work on either layout.
+ *          - Row based access (get_row, get_stride, GridView) and the halo need Layout::ROW_MAJOR,
+ *            Grid::to_layout converts between the two a tile at a time.
+ *
+ *      - A GridView is a read-only window onto the cells of a Grid that does not copy them.
+ *          - Views are made by Grid::view, GridView::crop, or implicitly from any Grid.
+ *          - Grid::merge, operator<<, and the Zoo savers all take views, so passing a Grid or
+ *            World::get_state() to them is free.
+ *          - A view is only valid while the grid it looks at is alive and is not resized, grown,
+ *            or swapped by World::step.
+ *
+ *      - The number of alive cells is maintained incrementally by every write, so counts are O(1).
+ *          - Handing out a modifiable row with get_row invalidates the count, the next count
+ *            rebuilds it with a popcount over the packed words.
+ *
+ *      - The bounding box of the alive cells is maintained incrementally too.
+ *          - Making a cell alive grows the box, killing a cell on its edge or any bulk write (merge,
+ *            get_row) only leaves it a loose bound, tightened lazily by a scan within the bound.
+ *          - World::step only computes the box plus a margin of one cell, and renderers and
+ *            savers can work on just the live cells through Grid::live_view.
+ *
+ *      - Grids can be hashed for equality and repeat checks on big states.
+ *          - Grid::hash mixes the packed cells a word at a time, Grid::hash_live hashes only the
+ *            live bounding box so a pattern hashes the same wherever it sits.
+ *          - An optional Zobrist hash is updated on every cell flip by set_unchecked, so World::step
+ *            keeps it current for free and checking a state against earlier ones is O(1).
+ *
+ *      - Cell access comes in two tiers.
+ *          - get, set, and operator() check their coordinates and throw when out of bounds.
+ *          - get_unchecked, set_unchecked, and get_row skip all checks for use in hot loops
+ *            that have already established their coordinates are valid.
  *
  * @author 954519
  * @date March, 2020
@@ -16,9 +74,15 @@
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
 #include "grid.h"
-#include <vector>
+#include "bits.h"
+#include "renderer.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 /**
  * Grid::Grid()
@@ -66,7 +130,7 @@ Grid::Grid(const unsigned int square_size) : Grid(square_size, square_size)
 }
 
 /**
- * Grid::Grid(width, height)
+ * Grid::Grid(width, height, halo = 0, arena = GridArena::get_default())
  *
  * Construct a grid with the desired size filled with dead cells.
  *
@@ -75,27 +139,258 @@ Grid::Grid(const unsigned int square_size) : Grid(square_size, square_size)
  *      // Make a 16x9 grid
  *      Grid grid(16, 9);
  *
+ *      // Make a 16x9 grid with a 1 cell ghost border for branch-free neighbourhood reads
+ *      Grid padded(16, 9, 1);
+ *
+ *      // Make a 16x9 grid with its cells allocated from a private pool
+ *      PoolArena pool;
+ *      Grid pooled(16, 9, 0, pool);
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @param halo
+ *      Optional parameter. The width of the ghost border around the grid, from 0 to 64 cells. Defaults to 0.
+ *
+ * @param arena
+ *      Optional parameter. The arena to allocate cells from, which must outlive the grid.
+ *      Defaults to GridArena::get_default().
+ *
+ * @throws
+ *      std::invalid_argument if the halo is wider than 64 cells.
+ */
+
+Grid::Grid(const unsigned int width, const unsigned int height, const unsigned int halo, GridArena &arena)
+    : width(width), height(height), halo(halo), layout(Layout::ROW_MAJOR), words_per_row((width + 63) / 64),
+      stride(get_stride(width, halo)), origin_x(0), origin_y(0), arena(&arena), cell_words(nullptr), capacity(0),
+      alive_cells(0), alive_cells_valid(true), live_box{0, 0, 0, 0}, live_box_tight(true),
+      zobrist_hash(0), zobrist_valid(true), zobrist_tracking(false)
+{
+    if (halo > 64)
+    {
+        throw std::invalid_argument("halo wider than 64 cells.");
+    }
+    //all bits start as 0 so all cells are dead
+    capacity = get_storage_words();
+    cell_words = arena.allocate(capacity);
+    std::fill_n(cell_words, capacity, 0);
+}
+
+/**
+ * Grid::Grid(width, height, layout, arena = GridArena::get_default())
+ *
+ * Construct a grid with the desired size and memory layout filled with dead cells.
+ * A Layout::TILED grid stores each 64x64 tile as 64 consecutive words, giving the 2d locality
+ * a row major layout lacks on wide grids. Tiled grids have no halo.
+ *
+ * @example
+ *
+ *      // Make a wide 100000x256 grid stored as 64x64 tiles
+ *      Grid grid(100000, 256, Layout::TILED);
+ *
  * @param width
  *      The width of the grid.
  *
  * @param height
  *      The height of the grid.
+ *
+ * @param layout
+ *      The order to store the packed words in.
+ *
+ * @param arena
+ *      Optional parameter. The arena to allocate cells from, which must outlive the grid.
+ *      Defaults to GridArena::get_default().
  */
+Grid::Grid(const unsigned int width, const unsigned int height, const Layout layout, GridArena &arena)
+    : width(width), height(height), halo(0), layout(layout), words_per_row((width + 63) / 64),
+      stride(get_stride(width, 0)), origin_x(0), origin_y(0), arena(&arena), cell_words(nullptr), capacity(0),
+      alive_cells(0), alive_cells_valid(true), live_box{0, 0, 0, 0}, live_box_tight(true),
+      zobrist_hash(0), zobrist_valid(true), zobrist_tracking(false)
+{
+    capacity = get_storage_words();
+    cell_words = arena.allocate(capacity);
+    std::fill_n(cell_words, capacity, 0);
+}
 
-Grid::Grid(const unsigned int width, const unsigned int height) : width(width), height(height)
+/**
+ * Grid::Grid(view, arena = GridArena::get_default())
+ *
+ * Construct a grid holding a copy of the cells seen through a view, copied a row at a time.
+ * Marked explicit so copies are never made implicitly when passing views around.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Take an owning copy of the centre 2x2
+ *      Grid centre(grid.view(1, 1, 3, 3));
+ *
+ * @param view
+ *      The view to copy.
+ *
+ * @param arena
+ *      Optional parameter. The arena to allocate cells from. Defaults to GridArena::get_default().
+ */
+Grid::Grid(const GridView &view, GridArena &arena) : Grid(view.get_width(), view.get_height(), 0, arena)
 {
-    //fill all cells with dead
+    //this grid starts empty so the change in set bits is the population of the view
     for (int y = 0; y < get_height(); y++)
     {
-        for (int x = 0; x < get_width(); x++)
+        alive_cells += copy_bits(cell_words + get_row_start(y), 0, view.get_row(y), view.get_offset(), width);
+    }
+    expand_live_box(0, 0, width, height);
+    live_box_tight = false;
+    zobrist_valid = false;
+}
+
+/**
+ * Grid::Grid(other)
+ *
+ * Construct a copy of another grid, including its halo, allocated from the same arena.
+ *
+ * @param other
+ *      The grid to copy.
+ */
+Grid::Grid(const Grid &other)
+    : width(other.width), height(other.height), halo(other.halo), layout(other.layout),
+      words_per_row(other.words_per_row), stride(other.stride), origin_x(other.origin_x), origin_y(other.origin_y),
+      arena(other.arena), cell_words(nullptr), capacity(other.get_storage_words()),
+      alive_cells(other.alive_cells), alive_cells_valid(other.alive_cells_valid),
+      live_box(other.live_box), live_box_tight(other.live_box_tight),
+      zobrist_hash(other.zobrist_hash), zobrist_valid(other.zobrist_valid), zobrist_tracking(other.zobrist_tracking)
+{
+    cell_words = arena->allocate(capacity);
+    std::copy_n(other.cell_words, capacity, cell_words);
+}
+
+/**
+ * Grid::Grid(other)
+ *
+ * Construct a grid by taking over the cells of another grid without copying them.
+ * The other grid is left as an empty 0x0 grid.
+ *
+ * @param other
+ *      The grid to move from.
+ */
+Grid::Grid(Grid &&other) noexcept
+    : width(other.width), height(other.height), halo(other.halo), layout(other.layout),
+      words_per_row(other.words_per_row), stride(other.stride), origin_x(other.origin_x), origin_y(other.origin_y),
+      arena(other.arena), cell_words(other.cell_words), capacity(other.capacity),
+      alive_cells(other.alive_cells), alive_cells_valid(other.alive_cells_valid),
+      live_box(other.live_box), live_box_tight(other.live_box_tight),
+      zobrist_hash(other.zobrist_hash), zobrist_valid(other.zobrist_valid), zobrist_tracking(other.zobrist_tracking)
+{
+    other.width = 0;
+    other.height = 0;
+    other.halo = 0;
+    other.layout = Layout::ROW_MAJOR;
+    other.words_per_row = 0;
+    other.stride = 0;
+    other.origin_x = 0;
+    other.origin_y = 0;
+    other.cell_words = nullptr;
+    other.capacity = 0;
+    other.alive_cells = 0;
+    other.alive_cells_valid = true;
+    other.live_box = BoundingBox{0, 0, 0, 0};
+    other.live_box_tight = true;
+    other.zobrist_hash = 0;
+    other.zobrist_valid = true;
+}
+
+/**
+ * Grid::operator=(other)
+ *
+ * Copy another grid, including its halo, into this one.
+ * The existing buffer is reused if it is big enough, otherwise a new one comes from this grid's arena.
+ *
+ * @param other
+ *      The grid to copy.
+ *
+ * @return
+ *      Returns a reference to this grid to enable operator chaining.
+ */
+Grid &Grid::operator=(const Grid &other)
+{
+    if (this != &other)
+    {
+        const std::size_t words = other.get_storage_words();
+        if (words > capacity)
         {
-            cell_grid.push_back(Cell::DEAD);
+            arena->deallocate(cell_words, capacity);
+            cell_words = nullptr;
+            capacity = 0;
+            cell_words = arena->allocate(words);
+            capacity = words;
         }
+        std::copy_n(other.cell_words, words, cell_words);
+
+        width = other.width;
+        height = other.height;
+        halo = other.halo;
+        layout = other.layout;
+        words_per_row = other.words_per_row;
+        stride = other.stride;
+        origin_x = other.origin_x;
+        origin_y = other.origin_y;
+        alive_cells = other.alive_cells;
+        alive_cells_valid = other.alive_cells_valid;
+        live_box = other.live_box;
+        live_box_tight = other.live_box_tight;
+        zobrist_hash = other.zobrist_hash;
+        zobrist_valid = other.zobrist_valid;
+        zobrist_tracking = other.zobrist_tracking;
     }
+    return *this;
+}
+
+/**
+ * Grid::operator=(other)
+ *
+ * Take over the cells of another grid without copying them, used by std::swap so the
+ * World buffers are exchanged in O(1). This grid's old cells are handed to the other grid.
+ *
+ * @param other
+ *      The grid to move from.
+ *
+ * @return
+ *      Returns a reference to this grid to enable operator chaining.
+ */
+Grid &Grid::operator=(Grid &&other) noexcept
+{
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(halo, other.halo);
+    std::swap(layout, other.layout);
+    std::swap(words_per_row, other.words_per_row);
+    std::swap(stride, other.stride);
+    std::swap(origin_x, other.origin_x);
+    std::swap(origin_y, other.origin_y);
+    std::swap(arena, other.arena);
+    std::swap(cell_words, other.cell_words);
+    std::swap(capacity, other.capacity);
+    std::swap(alive_cells, other.alive_cells);
+    std::swap(alive_cells_valid, other.alive_cells_valid);
+    std::swap(live_box, other.live_box);
+    std::swap(live_box_tight, other.live_box_tight);
+    std::swap(zobrist_hash, other.zobrist_hash);
+    std::swap(zobrist_valid, other.zobrist_valid);
+    std::swap(zobrist_tracking, other.zobrist_tracking);
+    return *this;
 }
 
+/**
+ * Grid::~Grid()
+ *
+ * Return the cells to the arena they were allocated from.
+ */
 Grid::~Grid()
 {
+    arena->deallocate(cell_words, capacity);
 }
 
 /**
@@ -178,18 +473,9 @@ int Grid::get_height() const
  *      The number of total cells.
  */
 
-unsigned int Grid::get_total_cells() const
+std::uint64_t Grid::get_total_cells() const
 {
-    unsigned int total_cells = 0;
-    //loop and increment total cells for every cell
-    for (int y = 0; y < get_height(); y++)
-    {
-        for (int x = 0; x < get_width(); x++)
-        {
-            total_cells++;
-        }
-    }
-    return total_cells;
+    return std::uint64_t(width) * height;
 }
 
 /**
@@ -197,6 +483,8 @@ unsigned int Grid::get_total_cells() const
  *
  * Counts how many cells in the grid are alive.
  * The function should be callable from a constant context.
+ * The count is maintained by every write so this is O(1), unless a modifiable row was handed
+ * out by Grid::get_row(y) since the last count, in which case it is rebuilt a word at a time.
  *
  * @example
  *
@@ -215,21 +503,13 @@ unsigned int Grid::get_total_cells() const
  * @return
  *      The number of alive cells.
  */
-unsigned int Grid::get_alive_cells() const
+std::uint64_t Grid::get_alive_cells() const
 {
-    unsigned int alive_cells = 0;
-    //loop and increment alive cells for every alive cell
-    for (int y = 0; y < get_height(); y++)
+    if (!alive_cells_valid)
     {
-        for (int x = 0; x < get_width(); x++)
-        {
-            if (get(x, y) == Cell::ALIVE)
-            {
-                alive_cells++;
-            }
-        }
+        alive_cells = count_alive_cells();
+        alive_cells_valid = true;
     }
-
     return alive_cells;
 }
 
@@ -238,6 +518,7 @@ unsigned int Grid::get_alive_cells() const
  *
  * Counts how many cells in the grid are dead.
  * The function should be callable from a constant context.
+ * Every cell that is not alive is dead so this is as cheap as Grid::get_alive_cells().
  *
  * @example
  *
@@ -256,484 +537,2823 @@ unsigned int Grid::get_alive_cells() const
  * @return
  *      The number of dead cells.
  */
-unsigned int Grid::get_dead_cells() const
+std::uint64_t Grid::get_dead_cells() const
 {
-    unsigned int dead_cells = 0;
-    //loop and incrememnt dead cells for every dead cell
-    for (int y = 0; y < get_height(); y++)
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * Grid::count_alive_cells()
+ *
+ * Private helper function to rebuild the alive cell count from scratch with a popcount
+ * over the packed words, 64 cells at a time.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+std::uint64_t Grid::count_alive_cells() const
+{
+    std::uint64_t count = 0;
+    if (layout == Layout::TILED)
     {
-        for (int x = 0; x < get_width(); x++)
+        //tiled grids have no halo, and padding past the width and height is always 0
+        for (std::size_t i = 0; i < get_storage_words(); i++)
         {
-            if (get(x, y) == Cell::DEAD)
-            {
-                dead_cells++;
-            }
+            count += count_bits(cell_words[i]);
         }
+        return count;
     }
 
-    return dead_cells;
+    for (int y = 0; y < get_height(); y++)
+    {
+        const std::uint64_t *row = get_row(y);
+        for (unsigned int i = 0; i < words_per_row; i++)
+        {
+            //mask off any right halo sharing the last word of the row
+            const std::uint64_t mask = (i + 1 < words_per_row || width % 64 == 0) ? ~std::uint64_t(0) : get_mask(width) - 1;
+            count += count_bits(row[i] & mask);
+        }
+    }
+    return count;
 }
 
 /**
- * Grid::resize(square_size)
+ * Grid::get_live_box()
  *
- * Resize the current grid to a new width and height that are equal. The content of the grid
- * should be preserved within the kept region and padded with Grid::DEAD if new cells are added.
+ * Gets the tight bounding box of the alive cells.
+ * The box is maintained by every write, when a write has only left a loose bound (a cell on the
+ * edge was killed, or cells were merged or written through get_row) it is tightened by scanning
+ * the words inside the bound, 64 cells at a time.
+ * The function should be callable from a constant context.
  *
  * @example
  *
- *      // Make a grid
- *      Grid grid(4, 4);
+ *      // Make a grid with two alive cells
+ *      Grid grid(100, 100);
+ *      grid.set(10, 20, Cell::ALIVE);
+ *      grid.set(30, 5, Cell::ALIVE);
  *
- *      // Resize the grid to be 8x8
- *      grid.resize(8);
+ *      // The box is x in [10, 31) and y in [5, 21)
+ *      BoundingBox box = grid.get_live_box();
  *
- * @param square_size
- *      The new edge size for both the width and height of the grid.
+ * @return
+ *      The smallest box holding every alive cell, or an empty box at 0,0 if no cells are alive.
  */
-
-void Grid::resize(unsigned int square_size)
+BoundingBox Grid::get_live_box() const
 {
-    //pass to the other resize
-    resize(square_size, square_size);
+    if (!live_box_tight)
+    {
+        live_box = find_live_box();
+        live_box_tight = true;
+    }
+    return live_box;
 }
+
 /**
- * Grid::resize(width, height)
+ * Grid::live_view()
  *
- * Resize the current grid to a new width and height. The content of the grid
- * should be preserved within the kept region and padded with Grid::DEAD if new cells are added.
+ * Make a read-only view of just the bounding box of the alive cells, so renderers and savers
+ * can skip the dead space around them.
+ * The function should be callable from a constant context.
  *
  * @example
  *
- *      // Make a grid
- *      Grid grid(4, 4);
+ *      // Save only the live part of a large world
+ *      Zoo::save_ascii("live.gol", world.get_state().live_view());
  *
- *      // Resize the grid to be 2x8
- *      grid.resize(2, 8);
+ * @return
+ *      A view of the live bounding box.
+ */
+GridView Grid::live_view() const
+{
+    const BoundingBox box = get_live_box();
+    return view(box.x0, box.y0, box.x1, box.y1);
+}
+
+/**
+ * Grid::clear()
  *
- * @param new_width
- *      The new width for the grid.
+ * Kill every cell of the grid. Only the words inside the live bounding box are cleared,
+ * so clearing a grid with few alive cells is cheap.
  *
- * @param new_height
- *      The new height for the grid.
+ * @example
+ *
+ *      // Make a grid, bring a cell to life, then kill everything again
+ *      Grid grid(1000, 1000);
+ *      grid.set(1, 1, Cell::ALIVE);
+ *      grid.clear();
+ */
+void Grid::clear()
+{
+    if (live_box.x0 < live_box.x1 && live_box.y0 < live_box.y1)
+    {
+        const unsigned int first_word = live_box.x0 / 64;
+        const unsigned int last_word = (live_box.x1 - 1) / 64;
+        for (int y = live_box.y0; y < live_box.y1; y++)
+        {
+            if (layout == Layout::ROW_MAJOR)
+            {
+                std::fill_n(cell_words + get_index(first_word * 64, y), last_word - first_word + 1, 0);
+                continue;
+            }
+            for (unsigned int i = first_word; i <= last_word; i++)
+            {
+                cell_words[get_index(i * 64, y)] = 0;
+            }
+        }
+    }
+    alive_cells = 0;
+    alive_cells_valid = true;
+    live_box = BoundingBox{0, 0, 0, 0};
+    live_box_tight = true;
+    zobrist_hash = 0;
+    zobrist_valid = true;
+}
+
+/**
+ * expand_box(box, x0, y0, x1, y1)
+ *
+ * Helper function to grow a box to cover the range [x0, x1) by [y0, y1), an empty box becomes the range.
  */
+static void expand_box(BoundingBox &box, const int x0, const int y0, const int x1, const int y1)
+{
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+    else if (box.x0 >= box.x1 || box.y0 >= box.y1)
+    {
+        box = BoundingBox{x0, y0, x1, y1};
+    }
+    else
+    {
+        box.x0 = std::min(box.x0, x0);
+        box.y0 = std::min(box.y0, y0);
+        box.x1 = std::max(box.x1, x1);
+        box.y1 = std::max(box.y1, y1);
+    }
+}
 
-void Grid::resize(const unsigned int new_width, const unsigned int new_height)
+/**
+ * Grid::expand_live_box(x0, y0, x1, y1)
+ *
+ * Private helper function to grow the live bounding box to cover the range [x0, x1) by [y0, y1).
+ * Callers that may have covered dead cells must also mark the box as no longer tight.
+ */
+void Grid::expand_live_box(const int x0, const int y0, const int x1, const int y1)
+{
+    expand_box(live_box, x0, y0, x1, y1);
+}
+
+/**
+ * Grid::find_live_box()
+ *
+ * Private helper function to find the tight bounding box of the alive cells by scanning the words
+ * inside the current loose bound, masked to the bound so halo bits are never counted.
+ *
+ * @return
+ *      The smallest box holding every alive cell, or an empty box at 0,0 if no cells are alive.
+ */
+BoundingBox Grid::find_live_box() const
 {
+    BoundingBox found = {0, 0, 0, 0};
+    if (live_box.x0 >= live_box.x1 || live_box.y0 >= live_box.y1)
+    {
+        return found;
+    }
 
-    std::vector<Cell> temp;
-    //loop through every cell of the new
-    for (unsigned int y = 0; y < new_height; y++)
+    const unsigned int first_word = live_box.x0 / 64;
+    const unsigned int last_word = (live_box.x1 - 1) / 64;
+    bool any = false;
+    for (int y = live_box.y0; y < live_box.y1; y++)
     {
-        for (unsigned int x = 0; x < new_width; x++)
+        for (unsigned int i = first_word; i <= last_word; i++)
         {
-            //if less than originals width and height pushback its values
-            if (((int)x < get_width()) && ((int)y < get_height()))
+            //mask the word down to the columns inside the bound
+            std::uint64_t word = cell_words[get_index(i * 64, y)];
+            if (i == first_word)
+            {
+                word &= ~(get_mask(live_box.x0) - 1);
+            }
+            if (i == last_word && live_box.x1 % 64 != 0)
+            {
+                word &= get_mask(live_box.x1) - 1;
+            }
+            if (word == 0)
+            {
+                continue;
+            }
+
+            const int low = i * 64 + lowest_bit(word);
+            const int high = i * 64 + highest_bit(word) + 1;
+            if (!any)
             {
-                temp.push_back(get(x, y));
+                found = BoundingBox{low, y, high, y + 1};
+                any = true;
             }
-            //when its more start pushing dead cells
             else
             {
-                temp.push_back(Cell::DEAD);
+                found.x0 = std::min(found.x0, low);
+                found.x1 = std::max(found.x1, high);
+                found.y1 = y + 1;
             }
         }
     }
-
-    this->cell_grid = temp;
-    this->width = new_width;
-    this->height = new_height;
+    return found;
 }
 
 /**
- * Grid::get_index(x, y)
+ * Grid::read_cells(x, y, count)
  *
- * Private helper function to determine the 1d index of a 2d coordinate.
- * Should not be visible from outside the Grid class.
- * The function should be callable from a constant context.
+ * Private helper function to read count (1 to 64) consecutive cells of a row starting at x,
+ * for either layout. The cells must lie inside [0, width).
  *
- * @param x
- *      The x coordinate of the cell.
+ * @return
+ *      The cells in the low bits of the result, the remaining high bits are 0.
+ */
+std::uint64_t Grid::read_cells(const int x, const int y, const unsigned int count) const
+{
+    const unsigned int shift = x % 64;
+    std::uint64_t value = cell_words[get_index(x, y)] >> shift;
+    //pull the rest from the next word of the row if the cells straddle a word boundary
+    if (shift + count > 64)
+    {
+        value |= cell_words[get_index(x + 64 - shift, y)] << (64 - shift);
+    }
+    if (count < 64)
+    {
+        value &= (std::uint64_t(1) << count) - 1;
+    }
+    return value;
+}
+
+/**
+ * Grid::hash_window(box)
  *
- * @param y
- *      The y coordinate of the cell.
+ * Private helper function to hash the cells inside a box, 64 cells per mix, seeded with the size
+ * of the box. The cells are read relative to the corner of the box, so the same pattern hashes
+ * the same wherever it sits, whatever the layout or halo of the grid.
  *
  * @return
- *      The 1d offset from the start of the data array where the desired cell is located.
+ *      The hash of the window.
  */
-unsigned int Grid::get_index(const unsigned int x, const unsigned int y) const
+std::uint64_t Grid::hash_window(const BoundingBox &box) const
 {
-    //formula to go from 2d to 1d index
-    return (x + get_width() * y);
+    std::uint64_t result = mix_bits((std::uint64_t(box.x1 - box.x0) << 32) | std::uint32_t(box.y1 - box.y0));
+    for (int y = box.y0; y < box.y1; y++)
+    {
+        for (int x = box.x0; x < box.x1; x += 64)
+        {
+            const unsigned int count = std::min(64, box.x1 - x);
+            result = mix_bits(result ^ read_cells(x, y, count));
+        }
+    }
+    return result;
 }
 
 /**
- * Grid::get(x, y)
+ * Grid::hash()
  *
- * Returns the value of the cell at the desired coordinate.
- * Specifically this function should return a cell value, not a reference to a cell.
+ * Hash every cell of the grid a word at a time. Grids with the same size and cells hash the same,
+ * whatever their layout, halo, or origin.
  * The function should be callable from a constant context.
- * Should be implemented by invoking Grid::operator()(x, y).
  *
  * @example
  *
- *      // Make a grid
- *      Grid grid(4, 4);
- *
- *      // Read the cell at coordinate (1, 2)
- *      Cell cell = grid.get(1, 2);
- *
- * @param x
- *      The x coordinate of the cell to update.
- *
- * @param y
- *      The y coordinate of the cell to update.
+ *      // Remember the hash of a grid to spot it again later
+ *      std::uint64_t seen = grid.hash();
  *
  * @return
- *      The value of the desired cell. Should only be Grid::ALIVE or Grid::DEAD.
- *
- * @throws
- *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ *      The hash of the grid.
  */
-Cell Grid::get(const int x, const int y) const
+std::uint64_t Grid::hash() const
 {
-    if (x >= get_width() || x < 0 || y >= get_height() || y < 0)
-    {
-        throw std::out_of_range("get is out of bounds.");
-    }
-    else
-    {
-        return operator()(x, y);
-    }
+    return hash_window(BoundingBox{0, 0, int(width), int(height)});
 }
 
 /**
- * Grid::set(x, y, value)
+ * Grid::hash_live()
  *
- * Overwrites the value at the desired coordinate.
- * Should be implemented by invoking Grid::operator()(x, y).
+ * Hash just the cells inside the live bounding box, so a pattern hashes the same wherever it sits
+ * in the grid and however big the grid is. Used to spot spaceships and oscillators that come back
+ * to the same shape somewhere else.
+ * The function should be callable from a constant context.
  *
  * @example
  *
- *      // Make a grid
- *      Grid grid(4, 4);
+ *      // A glider hashes the same every 4 generations as it moves
+ *      std::uint64_t before = world.get_state().hash_live();
+ *      world.advance(4);
+ *      bool same_shape = (before == world.get_state().hash_live());
  *
- *      // Assign to a cell at coordinate (1, 2)
- *      grid.set(1, 2, Cell::ALIVE);
+ * @return
+ *      The translation invariant hash of the alive cells.
+ */
+std::uint64_t Grid::hash_live() const
+{
+    return hash_window(get_live_box());
+}
+
+/**
+ * Grid::get_zobrist_key(x, y)
  *
- * @param x
- *      The x coordinate of the cell to update.
+ * Private helper function to get the random looking key a cell adds to the Zobrist hash when alive.
+ * Keys are derived from the coordinate rather than stored in a table, so grids of any size share them.
  *
- * @param y
- *      The y coordinate of the cell to update.
+ * @return
+ *      The key of the cell.
+ */
+std::uint64_t Grid::get_zobrist_key(const int x, const int y)
+{
+    return mix_bits((std::uint64_t(std::uint32_t(y)) << 32) | std::uint32_t(x));
+}
+
+/**
+ * Grid::find_zobrist_hash()
  *
- * @param value
- *      The value to be written to the selected cell.
+ * Private helper function to rebuild the Zobrist hash from scratch, visiting only the set bits
+ * inside the live bounding box, masked to the box so halo bits are never counted.
  *
- * @throws
- *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ * @return
+ *      The XOR of the keys of all alive cells.
  */
+std::uint64_t Grid::find_zobrist_hash() const
+{
+    std::uint64_t result = 0;
+    for (int y = live_box.y0; y < live_box.y1; y++)
+    {
+        for (int x = live_box.x0; x < live_box.x1; x += 64)
+        {
+            std::uint64_t bits = read_cells(x, y, std::min(64, live_box.x1 - x));
+            while (bits != 0)
+            {
+                result ^= get_zobrist_key(x + lowest_bit(bits), y);
+                bits &= bits - 1;
+            }
+        }
+    }
+    return result;
+}
 
-void Grid::set(const int x, const int y, Cell value)
+/**
+ * Grid::get_zobrist_hash()
+ *
+ * Gets the Zobrist hash of the grid, the XOR of a fixed key for each alive cell.
+ * With tracking on every cell flip updates the hash as it happens, so it is O(1) after any number
+ * of set_unchecked writes. Otherwise, or after a bulk write, it is rebuilt lazily on the next call.
+ * Unlike Grid::hash it depends only on which coordinates are alive, not on the grid size.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Track the hash as cells are written
+ *      Grid grid(1000, 1000);
+ *      grid.set_zobrist_tracking(true);
+ *      grid.set(1, 1, Cell::ALIVE);
+ *      std::uint64_t key = grid.get_zobrist_hash();
+ *
+ * @return
+ *      The Zobrist hash of the alive cells.
+ */
+std::uint64_t Grid::get_zobrist_hash() const
 {
-    operator()(x, y) = value;
+    if (!zobrist_valid)
+    {
+        zobrist_hash = find_zobrist_hash();
+        zobrist_valid = true;
+    }
+    return zobrist_hash;
 }
+
 /**
- * Grid::operator()(x, y)
+ * Grid::get_zobrist_tracking()
  *
- * Gets a modifiable reference to the value at the desired coordinate.
- * Should be implemented by invoking Grid::get_index(x, y).
+ * Gets whether the Zobrist hash is updated on every cell flip.
+ *
+ * @return
+ *      True if the hash is maintained incrementally.
+ */
+bool Grid::get_zobrist_tracking() const
+{
+    return zobrist_tracking;
+}
+
+/**
+ * Grid::set_zobrist_tracking(enabled)
+ *
+ * Sets whether the Zobrist hash is updated on every cell flip. Tracking costs a key mix per flip,
+ * so it is off by default and should be turned on for grids whose hash is checked often.
+ *
+ * @param enabled
+ *      True to maintain the hash incrementally.
+ */
+void Grid::set_zobrist_tracking(const bool enabled)
+{
+    if (enabled && !zobrist_tracking)
+    {
+        //bring the hash up to date so flips can be applied to it
+        get_zobrist_hash();
+    }
+    zobrist_tracking = enabled;
+}
+
+/**
+ * Grid::operator==(other)
+ *
+ * Compare the cells of two grids of the same size, whatever their layout, halo, or origin.
+ * Grids with different alive counts or Zobrist hashes are rejected without looking at the cells
+ * whenever those are already known, otherwise the cells are compared 64 at a time.
+ *
+ * @param other
+ *      The grid to compare with.
+ *
+ * @return
+ *      True if both grids are the same size with the same cells alive.
+ */
+bool Grid::operator==(const Grid &other) const
+{
+    if (width != other.width || height != other.height)
+    {
+        return false;
+    }
+    else if (alive_cells_valid && other.alive_cells_valid && alive_cells != other.alive_cells)
+    {
+        return false;
+    }
+    else if (zobrist_valid && other.zobrist_valid && zobrist_hash != other.zobrist_hash)
+    {
+        return false;
+    }
+    for (int y = 0; y < get_height(); y++)
+    {
+        for (int x = 0; x < get_width(); x += 64)
+        {
+            const unsigned int count = std::min(64, get_width() - x);
+            if (read_cells(x, y, count) != other.read_cells(x, y, count))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Grid::operator!=(other)
+ *
+ * Compare the cells of two grids, the negation of Grid::operator==.
+ *
+ * @param other
+ *      The grid to compare with.
+ *
+ * @return
+ *      True if the grids differ in size or in any cell.
+ */
+bool Grid::operator!=(const Grid &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Grid::resize(square_size)
+ *
+ * Resize the current grid to a new width and height that are equal. The content of the grid
+ * should be preserved within the kept region and padded with Grid::DEAD if new cells are added.
  *
  * @example
  *
  *      // Make a grid
  *      Grid grid(4, 4);
  *
- *      // Get access to read a cell at coordinate (1, 2)
- *      Cell cell = grid(1, 2);
+ *      // Resize the grid to be 8x8
+ *      grid.resize(8);
  *
- *      // Directly assign to a cell at coordinate (1, 2)
- *      grid(1, 2) = Cell::ALIVE;
+ * @param square_size
+ *      The new edge size for both the width and height of the grid.
+ */
+
+void Grid::resize(unsigned int square_size)
+{
+    //pass to the other resize
+    resize(square_size, square_size);
+}
+/**
+ * Grid::resize(width, height)
  *
- *      // Extract a reference to an individual cell to avoid calculating it's
- *      // 1d index multiple times if you need to access the cell more than once.
- *      Cell &cell_reference = grid(1, 2);
- *      cell_reference = Cell::DEAD;
- *      cell_reference = Cell::ALIVE;
+ * Resize the current grid to a new width and height. The content of the grid
+ * should be preserved within the kept region and padded with Grid::DEAD if new cells are added.
+ *
+ * Resizing happens in place whenever the buffer is big enough, moving rows with memmove,
+ * and reallocation grows the buffer geometrically. See Grid::grow to add cells above or to the left.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Resize the grid to be 2x8
+ *      grid.resize(2, 8);
+ *
+ * @param new_width
+ *      The new width for the grid.
+ *
+ * @param new_height
+ *      The new height for the grid.
+ */
+
+void Grid::resize(const unsigned int new_width, const unsigned int new_height)
+{
+    if (new_width != width || new_height != height)
+    {
+        relayout(new_width, new_height, 0, 0);
+    }
+}
+
+/**
+ * Grid::grow(left, top, right, bottom)
+ *
+ * Grow the grid by adding dead cells on any of its edges. The content of the grid is preserved,
+ * moving right by left cells and down by top cells, and the origin moves with it so the content
+ * keeps its logical coordinates. Like Grid::resize the grid is grown in place when it can be.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Add 2 columns on the left and 1 row on the bottom, making it 6x5
+ *      grid.grow(2, 0, 0, 1);
+ *
+ *      // The old cell (0, 0) is now at (2, 0), and the origin is (-2, 0)
+ *      Cell cell = grid.get(2, 0);
+ *
+ * @param left
+ *      The number of columns to add on the left edge.
+ *
+ * @param top
+ *      The number of rows to add on the top edge.
+ *
+ * @param right
+ *      The number of columns to add on the right edge.
+ *
+ * @param bottom
+ *      The number of rows to add on the bottom edge.
+ */
+void Grid::grow(const unsigned int left, const unsigned int top, const unsigned int right, const unsigned int bottom)
+{
+    if (left != 0 || top != 0 || right != 0 || bottom != 0)
+    {
+        relayout(width + left + right, height + top + bottom, left, top);
+        origin_x -= left;
+        origin_y -= top;
+    }
+}
+
+/**
+ * Grid::get_origin_x()
+ *
+ * Gets the logical x coordinate of cell (0, 0), which starts at 0 and moves left as the grid
+ * grows on its left edge.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The logical x coordinate of the left edge of the grid.
+ */
+int Grid::get_origin_x() const
+{
+    return origin_x;
+}
+
+/**
+ * Grid::get_origin_y()
+ *
+ * Gets the logical y coordinate of cell (0, 0), which starts at 0 and moves up as the grid
+ * grows on its top edge.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The logical y coordinate of the top edge of the grid.
+ */
+int Grid::get_origin_y() const
+{
+    return origin_y;
+}
+
+/**
+ * Grid::relayout(new_width, new_height, shift_x, shift_y)
+ *
+ * Private helper function behind Grid::resize and Grid::grow. Changes the size of the grid,
+ * moving the kept cells right by shift_x and down by shift_y, padding with dead cells.
+ *
+ * If the buffer is big enough the rows are moved in place with memmove, otherwise a new buffer
+ * is allocated with at least double the capacity, so repeated growth costs amortized O(1)
+ * allocations. The halo width is kept, the halo itself is cleared.
+ *
+ * The stride only shrinks when the grid is resized narrower, with no shift, so rows either all move
+ * towards the end of the buffer (walk them backwards) or all towards the start (walk them forwards),
+ * and no row is overwritten before it has been moved.
+ *
+ * @param new_width
+ *      The new width for the grid, at least shift_x.
+ *
+ * @param new_height
+ *      The new height for the grid, at least shift_y.
+ *
+ * @param shift_x
+ *      How far right to move the kept cells.
+ *
+ * @param shift_y
+ *      How far down to move the kept cells.
+ */
+void Grid::relayout(const unsigned int new_width, const unsigned int new_height,
+                    const unsigned int shift_x, const unsigned int shift_y)
+{
+    if (layout == Layout::TILED)
+    {
+        //rows are split across tiles, so move the cells through a row major copy
+        Grid row_major = to_layout(Layout::ROW_MAJOR);
+        row_major.relayout(new_width, new_height, shift_x, shift_y);
+        *this = row_major.to_layout(Layout::TILED);
+        return;
+    }
+
+    const unsigned int guard_words = get_guard_words(halo);
+    const unsigned int new_stride = get_stride(new_width, halo);
+    const std::size_t new_storage = std::size_t(new_stride) * (new_height + 2 * halo);
+
+    //the region of the old grid that survives
+    const unsigned int kept_width = std::min(width, new_width - shift_x);
+    const unsigned int kept_height = std::min(height, new_height - shift_y);
+    const unsigned int kept_words = (kept_width + 63) / 64;
+
+    if (new_storage > capacity)
+    {
+        //grow geometrically and copy the kept rows straight into the new buffer
+        const std::size_t new_capacity = std::max(new_storage, capacity * 2);
+        std::uint64_t *temp = arena->allocate(new_capacity);
+        std::fill_n(temp, new_storage, 0);
+        for (unsigned int y = 0; y < kept_height; y++)
+        {
+            copy_bits(temp + std::size_t(new_stride) * (y + shift_y + halo) + guard_words, shift_x,
+                      cell_words + get_row_start(y), 0, kept_width);
+        }
+        arena->deallocate(cell_words, capacity);
+        cell_words = temp;
+        capacity = new_capacity;
+    }
+    else
+    {
+        std::vector<std::uint64_t> scratch(shift_x ? kept_words : 0);
+        const bool backwards = new_stride >= stride;
+        for (unsigned int i = 0; i < kept_height; i++)
+        {
+            const unsigned int y = backwards ? kept_height - 1 - i : i;
+            const std::uint64_t *src = cell_words + get_row_start(y);
+            std::uint64_t *dst = cell_words + std::size_t(new_stride) * (y + shift_y + halo) + guard_words;
+            if (shift_x == 0)
+            {
+                std::memmove(dst, src, kept_words * sizeof(std::uint64_t));
+                //clear the guard words and everything past the kept width
+                std::fill_n(dst - guard_words, guard_words, 0);
+                if (kept_width % 64 != 0)
+                {
+                    dst[kept_words - 1] &= get_mask(kept_width) - 1;
+                }
+                std::fill_n(dst + kept_words, new_stride - guard_words - kept_words, 0);
+            }
+            else
+            {
+                //the row moves across bit positions so take a copy before clearing it
+                std::copy_n(src, kept_words, scratch.data());
+                std::fill_n(dst - guard_words, new_stride, 0);
+                copy_bits(dst, shift_x, scratch.data(), 0, kept_width);
+            }
+        }
+
+        //clear the added rows and the halo rows once everything has moved
+        for (unsigned int row = 0; row < new_height + 2 * halo; row++)
+        {
+            if (row < shift_y + halo || row >= shift_y + halo + kept_height)
+            {
+                std::fill_n(cell_words + std::size_t(new_stride) * row, new_stride, 0);
+            }
+        }
+    }
+
+    //only the kept cells are still alive, so recount lazily if any were dropped
+    if (kept_width < width || kept_height < height)
+    {
+        alive_cells_valid = false;
+    }
+    //move the live box with the cells, clipping it to the kept region
+    const BoundingBox moved = {std::min<int>(live_box.x0, kept_width) + int(shift_x), std::min<int>(live_box.y0, kept_height) + int(shift_y),
+                               std::min<int>(live_box.x1, kept_width) + int(shift_x), std::min<int>(live_box.y1, kept_height) + int(shift_y)};
+    if (moved.x1 - moved.x0 != live_box.x1 - live_box.x0 || moved.y1 - moved.y0 != live_box.y1 - live_box.y0)
+    {
+        live_box_tight = false;
+    }
+    //the zobrist keys depend on position, so any moved or dropped cell needs a recompute
+    if (shift_x != 0 || shift_y != 0 || kept_width < width || kept_height < height)
+    {
+        zobrist_valid = false;
+    }
+    live_box = (moved.x0 < moved.x1 && moved.y0 < moved.y1) ? moved : BoundingBox{0, 0, 0, 0};
+    width = new_width;
+    height = new_height;
+    words_per_row = (new_width + 63) / 64;
+    stride = new_stride;
+}
+
+/**
+ * Grid::get_guard_words(halo)
+ *
+ * Private helper function to determine the number of words to the left of cell 0 in each row.
+ * A grid with a halo gets a whole cache line of guard words, the last of which holds the
+ * left halo, so cell 0 stays cache line aligned.
+ *
+ * @param halo
+ *      The width of the ghost border.
+ *
+ * @return
+ *      The number of guard words.
+ */
+unsigned int Grid::get_guard_words(const unsigned int halo)
+{
+    return halo ? GridArena::ALIGNMENT_WORDS : 0;
+}
+
+/**
+ * Grid::get_stride(width, halo)
+ *
+ * Private helper function to determine the number of words between the starts of two rows.
+ * A grid with a halo gets guard words to the left of each row and room for the right halo.
+ * The stride is rounded up to whole cache lines so every row starts aligned.
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param halo
+ *      The width of the ghost border.
+ *
+ * @return
+ *      The row stride in words.
+ */
+unsigned int Grid::get_stride(const unsigned int width, const unsigned int halo)
+{
+    const unsigned int words = get_guard_words(halo) + (width + halo + 63) / 64;
+    return (words + GridArena::ALIGNMENT_WORDS - 1) / GridArena::ALIGNMENT_WORDS * GridArena::ALIGNMENT_WORDS;
+}
+
+/**
+ * Grid::get_storage_words()
+ *
+ * Private helper function to determine the number of words used by all rows, including halo rows.
+ * A tiled grid always stores whole tiles, so its height is padded to a multiple of 64.
+ *
+ * @return
+ *      The number of words in use from the start of the cell buffer.
+ */
+std::size_t Grid::get_storage_words() const
+{
+    if (layout == Layout::TILED)
+    {
+        return std::size_t(words_per_row) * ((height + 63) / 64) * 64;
+    }
+    return std::size_t(stride) * (height + 2 * halo);
+}
+
+/**
+ * Grid::get_row_start(y)
+ *
+ * Private helper function to determine the 1d index of the word holding cell 0 of a row,
+ * skipping over the halo rows above and the guard words to the left.
+ * In a tiled grid the following words of the row are 64 words apart, one per tile.
+ *
+ * @param y
+ *      The y coordinate of the row, from -halo to height + halo - 1.
+ *
+ * @return
+ *      The 1d offset from the start of the word array of the first word of the row.
+ */
+std::size_t Grid::get_row_start(const int y) const
+{
+    if (layout == Layout::TILED)
+    {
+        return std::size_t(y / 64) * words_per_row * 64 + y % 64;
+    }
+    return std::size_t(stride) * (y + halo) + get_guard_words(halo);
+}
+
+/**
+ * Grid::get_index(x, y)
+ *
+ * Private helper function to determine the 1d index of a 2d coordinate.
+ * Should not be visible from outside the Grid class.
+ * The function should be callable from a constant context.
+ *
+ * @param x
+ *      The x coordinate of the cell, from -halo to width + halo - 1.
+ *
+ * @param y
+ *      The y coordinate of the cell, from -halo to height + halo - 1.
+ *
+ * @return
+ *      The 1d offset from the start of the word array of the word holding the desired cell.
+ */
+std::size_t Grid::get_index(const int x, const int y) const
+{
+    if (layout == Layout::ROW_MAJOR)
+    {
+        //formula to go from 2d to 1d index, 64 cells per word,
+        //x is never below -64 so shift it positive to get a rounded down division
+        return std::size_t(stride) * (y + halo) + get_guard_words(halo) + (x + 64) / 64 - 1;
+    }
+    //tiles are 64 words, one per row, stored one after another along the row of tiles
+    return (std::size_t(y / 64) * words_per_row + x / 64) * 64 + y % 64;
+}
+
+/**
+ * Grid::get_mask(x)
+ *
+ * Private helper function to determine which bit of its word holds the cell in column x.
+ *
+ * @param x
+ *      The x coordinate of the cell, may be negative for cells in the left halo.
+ *
+ * @return
+ *      A word with only the bit for the desired cell set.
+ */
+std::uint64_t Grid::get_mask(const int x)
+{
+    return std::uint64_t(1) << (x & 63);
+}
+
+/**
+ * Grid::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate.
+ * Specifically this function should return a cell value, not a reference to a cell.
+ * The function should be callable from a constant context.
+ * Checks the coordinate once then reads it with Grid::get_unchecked(x, y).
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Read the cell at coordinate (1, 2)
+ *      Cell cell = grid.get(1, 2);
+ *
+ * @param x
+ *      The x coordinate of the cell to update.
+ *
+ * @param y
+ *      The y coordinate of the cell to update.
+ *
+ * @return
+ *      The value of the desired cell. Should only be Grid::ALIVE or Grid::DEAD.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+Cell Grid::get(const int x, const int y) const
+{
+    if (x >= get_width() || x < 0 || y >= get_height() || y < 0)
+    {
+        throw std::out_of_range("get is out of bounds.");
+    }
+    else
+    {
+        return get_unchecked(x, y);
+    }
+}
+
+/**
+ * Grid::set(x, y, value)
+ *
+ * Overwrites the value at the desired coordinate.
+ * Checks the coordinate like Grid::operator()(x, y), then writes with Grid::set_unchecked(x, y, value)
+ * so the live bounding box stays tight.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Assign to a cell at coordinate (1, 2)
+ *      grid.set(1, 2, Cell::ALIVE);
+ *
+ * @param x
+ *      The x coordinate of the cell to update.
+ *
+ * @param y
+ *      The y coordinate of the cell to update.
+ *
+ * @param value
+ *      The value to be written to the selected cell.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+
+void Grid::set(const int x, const int y, Cell value)
+{
+    if (x >= get_width() || y >= get_height() || x < 0 || y < 0)
+    {
+        throw std::runtime_error("Grid::operator() out of bounds.");
+    }
+    set_unchecked(x, y, value);
+}
+
+/**
+ * Grid::get_unchecked(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate without any bounds checking.
+ * Intended for hot loops such as World::step that iterate over coordinates known to be valid.
+ * Cells in the halo of the grid, if it has one, can also be read.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Read every cell without paying for a bounds check on each one
+ *      for (int y = 0; y < grid.get_height(); y++)
+ *          for (int x = 0; x < grid.get_width(); x++)
+ *              Cell cell = grid.get_unchecked(x, y);
+ *
+ * @param x
+ *      The x coordinate of the cell to read, must be in [-halo, width + halo).
+ *
+ * @param y
+ *      The y coordinate of the cell to read, must be in [-halo, height + halo).
+ *
+ * @return
+ *      The value of the desired cell. The result is undefined if x,y is not a valid coordinate.
+ */
+Cell Grid::get_unchecked(const int x, const int y) const noexcept
+{
+    return (cell_words[get_index(x, y)] & get_mask(x)) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * Grid::set_unchecked(x, y, value)
+ *
+ * Overwrites the value at the desired coordinate without any bounds checking.
+ * Intended for hot loops that iterate over coordinates known to be valid.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Fill the grid without paying for a bounds check on each cell
+ *      for (int y = 0; y < grid.get_height(); y++)
+ *          for (int x = 0; x < grid.get_width(); x++)
+ *              grid.set_unchecked(x, y, Cell::ALIVE);
+ *
+ * @param x
+ *      The x coordinate of the cell to update, must be in [0, width).
+ *
+ * @param y
+ *      The y coordinate of the cell to update, must be in [0, height).
+ *
+ * @param value
+ *      The value to be written. The behaviour is undefined if x,y is not a valid coordinate.
+ */
+void Grid::set_unchecked(const int x, const int y, const Cell value) noexcept
+{
+    std::uint64_t &word = cell_words[get_index(x, y)];
+    const std::uint64_t mask = get_mask(x);
+    if (!zobrist_tracking)
+    {
+        zobrist_valid = false;
+    }
+    else if (((word & mask) != 0) != (value == Cell::ALIVE))
+    {
+        //a flipped cell toggles its key in or out of the hash
+        zobrist_hash ^= get_zobrist_key(x, y);
+    }
+    CellReference(word, mask, alive_cells) = value;
+    if (value == Cell::ALIVE)
+    {
+        expand_live_box(x, y, x + 1, y + 1);
+    }
+    else if (x == live_box.x0 || x + 1 == live_box.x1 || y == live_box.y0 || y + 1 == live_box.y1)
+    {
+        //killing a cell on the edge of the box may shrink it
+        live_box_tight = false;
+    }
+}
+
+/**
+ * Grid::set_word_unchecked(x, y, word)
+ *
+ * Overwrites the 64 cells of a row starting at x with the bits of a word, without any bounds checking.
+ * Intended for kernels that compute a whole word of cells at once. Keeps the alive cell count,
+ * live bounding box, and Zobrist hash up to date like set_unchecked, a word at a time.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(128, 4);
+ *
+ *      // Bring cells 64 to 127 of row 2 to life in one write
+ *      grid.set_word_unchecked(64, 2, ~std::uint64_t(0));
+ *
+ * @param x
+ *      The x coordinate of the first cell to update, must be a multiple of 64 in [0, width).
+ *
+ * @param y
+ *      The y coordinate of the row to update, must be in [0, height).
+ *
+ * @param word
+ *      The cells to be written, bit i is cell x + i. Bits for cells past the width must be 0.
+ *      The behaviour is undefined if x,y is not a valid coordinate.
+ */
+void Grid::set_word_unchecked(const int x, const int y, const std::uint64_t word) noexcept
+{
+    set_words_unchecked(x, y, &word, 1);
+}
+
+/**
+ * Grid::set_words_unchecked(x, y, words, count)
+ *
+ * Overwrites count words of cells of a row starting at x, without any bounds checking.
+ * The bulk form of set_word_unchecked for kernels that compute a row of words at once, the counts,
+ * live bounding box, and Zobrist hash are updated once for the whole run.
+ *
+ * @param x
+ *      The x coordinate of the first cell to update, must be a multiple of 64 in [0, width).
+ *
+ * @param y
+ *      The y coordinate of the row to update, must be in [0, height).
+ *
+ * @param words
+ *      The cells to be written, bit i of words[k] is cell x + 64 * k + i. Bits for cells past the
+ *      width must be 0. The behaviour is undefined if any written cell is not a valid coordinate.
+ *
+ * @param count
+ *      The number of words to write.
+ */
+void Grid::set_words_unchecked(const int x, const int y, const std::uint64_t *words, const unsigned int count) noexcept
+{
+    GridDelta delta = {};
+    set_words_unchecked(x, y, words, count, delta);
+    merge_delta(delta);
+}
+
+/**
+ * Grid::set_words_unchecked(x, y, words, count, delta)
+ *
+ * Overwrites count words of cells of a row starting at x, without any bounds checking, collecting
+ * the changes to the counts, live bounding box, and Zobrist hash in a delta instead of the grid.
+ * Only the written words are touched, so threads can write disjoint rows at the same time as long as
+ * each keeps its own delta, then merge the deltas one at a time with Grid::merge_delta.
+ *
+ * @example
+ *
+ *      // Write two rows independently, then bring the counts up to date
+ *      GridDelta top = {};
+ *      GridDelta bottom = {};
+ *      grid.set_words_unchecked(0, 0, top_words, words, top);
+ *      grid.set_words_unchecked(0, 1, bottom_words, words, bottom);
+ *      grid.merge_delta(top);
+ *      grid.merge_delta(bottom);
+ *
+ * @param x
+ *      The x coordinate of the first cell to update, must be a multiple of 64 in [0, width).
+ *
+ * @param y
+ *      The y coordinate of the row to update, must be in [0, height).
+ *
+ * @param words
+ *      The cells to be written, bit i of words[k] is cell x + 64 * k + i. Bits for cells past the
+ *      width must be 0. The behaviour is undefined if any written cell is not a valid coordinate.
+ *
+ * @param count
+ *      The number of words to write.
+ *
+ * @param delta
+ *      The delta to add the changes to.
+ */
+void Grid::set_words_unchecked(const int x, const int y, const std::uint64_t *words, const unsigned int count,
+                               GridDelta &delta) noexcept
+{
+    //row major rows are contiguous so only tiled rows need an index per word
+    std::uint64_t *row = (layout == Layout::ROW_MAJOR) ? cell_words + get_index(x, y) : nullptr;
+    int first_alive = -1;
+    int last_alive = -1;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const int word_x = x + 64 * int(i);
+        std::uint64_t &target = row ? row[i] : cell_words[get_index(word_x, y)];
+        //halo bits past the width are not cells, so they are kept and left out of the counts
+        const std::uint64_t cells = (word_x + 64 > int(width)) ? get_mask(width) - 1 : ~std::uint64_t(0);
+        const std::uint64_t old = target & cells;
+        const std::uint64_t word = words[i];
+        if (word != 0)
+        {
+            first_alive = (first_alive < 0) ? int(i) : first_alive;
+            last_alive = int(i);
+        }
+        const std::uint64_t changed = old ^ word;
+        if (changed == 0)
+        {
+            continue;
+        }
+
+        delta.alive_cells += (long long)count_bits(word) - count_bits(old);
+        delta.changed = true;
+        delta.killed = delta.killed || (changed & old) != 0;
+        if (zobrist_tracking)
+        {
+            //each flipped cell toggles its key in or out of the hash
+            for (std::uint64_t bits = changed; bits != 0; bits &= bits - 1)
+            {
+                delta.zobrist_hash ^= get_zobrist_key(word_x + lowest_bit(bits), y);
+            }
+        }
+        target = (target & ~cells) | word;
+    }
+
+    //alive cells already in the box leave it unchanged, so cover every alive cell of the run
+    if (first_alive >= 0)
+    {
+        expand_box(delta.born, x + 64 * first_alive + lowest_bit(words[first_alive]), y,
+                   x + 64 * last_alive + highest_bit(words[last_alive]) + 1, y + 1);
+    }
+}
+
+/**
+ * Grid::merge_delta(delta)
+ *
+ * Bring the alive cell count, live bounding box, and Zobrist hash up to date with the writes
+ * collected in a delta by Grid::set_words_unchecked. Each delta must be merged exactly once.
+ *
+ * @param delta
+ *      The changes to merge.
+ */
+void Grid::merge_delta(const GridDelta &delta) noexcept
+{
+    if (!delta.changed)
+    {
+        return;
+    }
+    alive_cells += delta.alive_cells;
+    zobrist_hash ^= delta.zobrist_hash;
+    zobrist_valid = zobrist_valid && zobrist_tracking;
+    expand_live_box(delta.born.x0, delta.born.y0, delta.born.x1, delta.born.y1);
+    if (delta.killed)
+    {
+        //killed cells may have been on the edge of the box
+        live_box_tight = false;
+    }
+}
+
+/**
+ * Grid::get_words_per_row()
+ *
+ * Gets the number of packed words used to store each row, the span of Grid::get_row(y).
+ * Cell x of a row is bit (x % 64) of word (x / 64), bits past the width are 0 unless the grid has a halo.
+ *
+ * @return
+ *      The number of std::uint64_t words in each row.
+ */
+unsigned int Grid::get_words_per_row() const noexcept
+{
+    return words_per_row;
+}
+
+/**
+ * Grid::get_stride()
+ *
+ * Gets the number of packed words between the starts of two consecutive rows.
+ * At least Grid::get_words_per_row(), rounded up to whole cache lines. With a halo it also
+ * covers the guard words before each row, the last at index -1 holds the left halo,
+ * and the words holding the right halo. Only meaningful for Layout::ROW_MAJOR grids.
+ *
+ * @return
+ *      The row stride in std::uint64_t words.
+ */
+unsigned int Grid::get_stride() const noexcept
+{
+    return stride;
+}
+
+/**
+ * Grid::get_row(y)
+ *
+ * Gets a pointer to the packed words of a row, spanning Grid::get_words_per_row() words,
+ * so kernels can work on whole rows a word at a time without any bounds checking.
+ *
+ * Writers must keep the bits past the width in the last word of the row 0.
+ * In a Layout::TILED grid the words of a row are 64 apart rather than consecutive.
+ * Because the grid cannot see writes through the pointer, calling this invalidates the
+ * maintained alive cell count, and the next count rebuilds it with a popcount.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(100, 4);
+ *
+ *      // Make the first 64 cells of row 2 alive
+ *      grid.get_row(2)[0] = ~std::uint64_t(0);
+ *
+ * @param y
+ *      The y coordinate of the row, must be in [-halo, height + halo).
+ *
+ * @return
+ *      A pointer to the first word of the row. The result is undefined if y is not a valid row.
+ */
+std::uint64_t *Grid::get_row(const int y) noexcept
+{
+    alive_cells_valid = false;
+    expand_live_box(0, 0, width, height);
+    live_box_tight = false;
+    zobrist_valid = false;
+    return cell_words + get_row_start(y);
+}
+
+/**
+ * Grid::get_row(y)
+ *
+ * Gets a read-only pointer to the packed words of a row, spanning Grid::get_words_per_row() words.
+ * The function should be callable from a constant context.
+ *
+ * @param y
+ *      The y coordinate of the row, must be in [-halo, height + halo).
+ *
+ * @return
+ *      A read-only pointer to the first word of the row. The result is undefined if y is not a valid row.
+ */
+const std::uint64_t *Grid::get_row(const int y) const noexcept
+{
+    return cell_words + get_row_start(y);
+}
+
+/**
+ * Grid::get_halo()
+ *
+ * Gets the width of the ghost border around the grid.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      The halo width in cells, 0 if the grid has no halo.
+ */
+int Grid::get_halo() const
+{
+    return halo;
+}
+
+/**
+ * Grid::refresh_row_halo(y, toroidal)
+ *
+ * Private helper function to refill the left and right halo of one row, a word at a time.
+ *
+ * @param y
+ *      The row, inside the grid.
+ *
+ * @param toroidal
+ *      If true the halo is filled with copies of the opposite edges of the row, otherwise with dead cells.
+ */
+void Grid::refresh_row_halo(const int y, const bool toroidal)
+{
+    //work from the last guard word of the row, where cell x is at bit guard + x
+    const std::size_t guard = 64;
+    std::uint64_t *row = cell_words + get_row_start(y) - 1;
+    if (toroidal && width >= halo)
+    {
+        copy_bits(row, guard - halo, row, guard + width - halo, halo);
+        copy_bits(row, guard + width, row, guard, halo);
+    }
+    else if (toroidal && width > 0)
+    {
+        //the halo is wider than the grid so it wraps around more than once,
+        //halo cell -k wraps to width - k and halo cell width + k - 1 wraps to k - 1
+        for (unsigned int k = 1; k <= halo; k++)
+        {
+            copy_bits(row, guard - k, row, guard + (width - k % width) % width, 1);
+            copy_bits(row, guard + width + k - 1, row, guard + (k - 1) % width, 1);
+        }
+    }
+    else
+    {
+        //the whole last guard word is halo, then clear everything past the width
+        const unsigned int row_words = stride - get_guard_words(halo) + 1;
+        row[0] = 0;
+        row[1 + width / 64] &= get_mask(width) - 1;
+        for (unsigned int i = 2 + width / 64; i < row_words; i++)
+        {
+            row[i] = 0;
+        }
+    }
+}
+
+/**
+ * Grid::refresh_halo_rows(toroidal, top, bottom)
+ *
+ * Private helper function to refill whole halo rows above and below the grid. They are copied
+ * with the left and right halo of the rows they come from, so those must be refreshed first.
+ *
+ * @param toroidal
+ *      If true the halo rows are copies of the rows on the opposite edge, otherwise they are dead.
+ *
+ * @param top
+ *      If true the halo rows above the grid are refilled.
+ *
+ * @param bottom
+ *      If true the halo rows below the grid are refilled.
+ */
+void Grid::refresh_halo_rows(const bool toroidal, const bool top, const bool bottom)
+{
+    for (unsigned int k = 1; k <= halo; k++)
+    {
+        std::uint64_t *above = cell_words + std::size_t(stride) * (halo - k);
+        std::uint64_t *below = cell_words + std::size_t(stride) * (halo + height + k - 1);
+        if (toroidal && height > 0)
+        {
+            const std::uint64_t *above_source = cell_words + std::size_t(stride) * (halo + (height - k % height) % height);
+            const std::uint64_t *below_source = cell_words + std::size_t(stride) * (halo + (k - 1) % height);
+            std::copy(above_source, above_source + stride * top, above);
+            std::copy(below_source, below_source + stride * bottom, below);
+        }
+        else
+        {
+            std::fill_n(above, stride * top, 0);
+            std::fill_n(below, stride * bottom, 0);
+        }
+    }
+}
+
+/**
+ * Grid::refresh_halo(toroidal)
+ *
+ * Refill the ghost border around the grid from its current contents, a word at a time.
+ * The left and right halo of every row are filled first, then whole halo rows are copied
+ * so the corners pick up the already refreshed columns.
+ *
+ * Does not change any cell inside the grid or the alive cell count. Does nothing without a halo.
+ *
+ * @example
+ *
+ *      // Make a grid with a 1 cell halo
+ *      Grid grid(8, 8, 1);
+ *      grid(7, 0) = Cell::ALIVE;
+ *
+ *      // Wrap the edges into the halo
+ *      grid.refresh_halo(true);
+ *
+ *      // The cell to the upper left of (0, 7) is now (7, 0)
+ *      Cell cell = grid.get_unchecked(-1, 8);
+ *
+ * @param toroidal
+ *      If true the halo is filled with copies of the opposite edges of the grid as on a torus,
+ *      otherwise the halo is filled with dead cells.
+ */
+void Grid::refresh_halo(const bool toroidal)
+{
+    if (halo == 0)
+    {
+        return;
+    }
+    for (int y = 0; y < get_height(); y++)
+    {
+        refresh_row_halo(y, toroidal);
+    }
+    refresh_halo_rows(toroidal, true, true);
+}
+
+/**
+ * Grid::refresh_halo(toroidal, region)
+ *
+ * Refill only the halo cells within halo cells of a region, the ones a neighbourhood of that size
+ * around any cell of the region can reach, see Grid::refresh_halo(toroidal).
+ * A region away from every edge costs nothing, one along an edge costs its height or a row of words,
+ * so stepping a few small regions of a large grid does not pay for the whole border.
+ *
+ * @example
+ *
+ *      // Make a grid with a 1 cell halo
+ *      Grid grid(1024, 1024, 1);
+ *      grid(0, 0) = Cell::ALIVE;
+ *
+ *      // Wrap the edges next to the top left corner into the halo, the cell to its upper left is (1023, 1023)
+ *      grid.refresh_halo(true, BoundingBox{0, 0, 32, 32});
+ *
+ * @param toroidal
+ *      If true the halo is filled with copies of the opposite edges of the grid as on a torus,
+ *      otherwise the halo is filled with dead cells.
+ *
+ * @param region
+ *      The cells whose neighbourhoods need the halo, inside the grid.
+ */
+void Grid::refresh_halo(const bool toroidal, const BoundingBox &region)
+{
+    const int reach = halo;
+    if (reach == 0 || region.x0 >= region.x1 || region.y0 >= region.y1)
+    {
+        return;
+    }
+
+    //the rows the region reaches wrap over the top and bottom on a torus, the corners come with them
+    if (region.x0 < reach || region.x1 > get_width() - reach)
+    {
+        const bool all_rows = toroidal && region.y1 - region.y0 + 2 * reach >= get_height();
+        const int y0 = all_rows ? 0 : region.y0 - reach;
+        const int y1 = all_rows ? get_height() : region.y1 + reach;
+        for (int y = y0; y < y1; y++)
+        {
+            const int wrapped = (y % get_height() + get_height()) % get_height();
+            if (toroidal || wrapped == y)
+            {
+                refresh_row_halo(wrapped, toroidal);
+            }
+        }
+    }
+    refresh_halo_rows(toroidal, region.y0 < reach, region.y1 > get_height() - reach);
+}
+/**
+ * Grid::operator()(x, y)
+ *
+ * Gets a modifiable reference to the value at the desired coordinate.
+ * Should be implemented by invoking Grid::get_index(x, y).
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Get access to read a cell at coordinate (1, 2)
+ *      Cell cell = grid(1, 2);
+ *
+ *      // Directly assign to a cell at coordinate (1, 2)
+ *      grid(1, 2) = Cell::ALIVE;
+ *
+ *      // Extract a reference to an individual cell to avoid calculating it's
+ *      // 1d index multiple times if you need to access the cell more than once.
+ *      // Cells are bit-packed so the reference is a Grid::CellReference proxy.
+ *      Grid::CellReference cell_reference = grid(1, 2);
+ *      cell_reference = Cell::DEAD;
+ *      cell_reference = Cell::ALIVE;
+ *
+ * @param x
+ *      The x coordinate of the cell to access.
+ *
+ * @param y
+ *      The y coordinate of the cell to access.
+ *
+ * @return
+ *      A modifiable Grid::CellReference proxy to the desired cell.
+ *
+ * @throws
+ *      std::runtime_error or sub-class if x,y is not a valid coordinate within the grid.
+ */
+Grid::CellReference Grid::operator()(const int x, const int y)
+{
+    if (x >= get_width() || y >= get_height() || x < 0 || y < 0)
+    {
+        throw std::runtime_error("Grid::operator() out of bounds.");
+    }
+    else
+    {
+        //the proxy might write either value, so the box can only be kept as a bound
+        expand_live_box(x, y, x + 1, y + 1);
+        live_box_tight = false;
+        zobrist_valid = false;
+        return CellReference(cell_words[get_index(x, y)], get_mask(x), alive_cells);
+    }
+}
+
+/**
+ * Grid::operator()(x, y)
+ *
+ * Gets the value at the desired coordinate for read-only access.
+ * The operator should be callable from a constant context.
+ * Should be implemented by invoking Grid::get_index(x, y).
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Constant reference to a grid (does not make a copy)
+ *      const Grid &read_only_grid = grid;
+ *
+ *      // Get access to read a cell at coordinate (1, 2)
+ *      Cell cell = read_only_grid(1, 2);
+ *
+ * @param x
+ *      The x coordinate of the cell to access.
+ *
+ * @param y
+ *      The y coordinate of the cell to access.
+ *
+ * @return
+ *      The value of the desired cell, cells are bit-packed so there is no Cell to refer to.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+Cell Grid::operator()(const int x, const int y) const
+{
+    if (x >= get_width() || y >= get_height() || x < 0 || y < 0)
+    {
+        throw std::runtime_error("Grid::operator() out of bounds.");
+    }
+    else
+    {
+        return get_unchecked(x, y);
+    }
+}
+
+/**
+ * Grid::CellReference::CellReference(word, mask, alive_cells)
+ *
+ * Construct a proxy for the cell stored in the bit selected by mask of a packed word.
+ * Normally only made by Grid::operator()(x, y).
+ *
+ * @param word
+ *      The word holding the cell.
+ *
+ * @param mask
+ *      A word with only the bit for the cell set.
+ *
+ * @param alive_cells
+ *      The alive cell count of the owning grid, kept up to date by writes through the proxy.
+ */
+Grid::CellReference::CellReference(std::uint64_t &word, const std::uint64_t mask, std::uint64_t &alive_cells)
+    : word(word), mask(mask), alive_cells(alive_cells)
+{
+}
+
+/**
+ * Grid::CellReference::operator Cell()
+ *
+ * Read the referenced cell, lets a proxy be used anywhere a Cell value is expected.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Read a cell through the proxy
+ *      Cell cell = grid(1, 2);
+ *
+ * @return
+ *      Cell::ALIVE if the bit is set, otherwise Cell::DEAD.
+ */
+Grid::CellReference::operator Cell() const
+{
+    return (word & mask) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * Grid::CellReference::operator=(value)
+ *
+ * Write to the referenced cell.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Write a cell through the proxy
+ *      grid(1, 2) = Cell::ALIVE;
+ *
+ * @param value
+ *      The value to be written to the cell.
+ *
+ * @return
+ *      Returns a reference to the proxy to enable operator chaining.
+ */
+Grid::CellReference &Grid::CellReference::operator=(const Cell value)
+{
+    const bool was_alive = (word & mask) != 0;
+    if (value == Cell::ALIVE)
+    {
+        word |= mask;
+    }
+    else
+    {
+        word &= ~mask;
+    }
+    //adjust the count by the change without branching on it
+    alive_cells = alive_cells + (value == Cell::ALIVE) - was_alive;
+    return *this;
+}
+
+/**
+ * Grid::CellReference::operator=(other)
+ *
+ * Copy the value of another cell into the referenced cell, so grid(0, 0) = grid(1, 1)
+ * copies the cell like it would with a Cell reference rather than rebinding the proxy.
+ *
+ * @param other
+ *      A proxy to the cell to be read.
+ *
+ * @return
+ *      Returns a reference to the proxy to enable operator chaining.
+ */
+Grid::CellReference &Grid::CellReference::operator=(const CellReference &other)
+{
+    return operator=(Cell(other));
+}
+/**
+ * Grid::crop(x0, y0, x1, y1)
+ *
+ * Extract a sub-grid from a Grid.
+ * The cropped grid spans the range [x0, x1) by [y0, y1) in the original grid.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid y(4, 4);
+ *
+ *      // Crop the centre 2x2 in y, trimming a 1 cell border off all sides
+ *      Grid x = y.crop(x, 1, 1, 3, 3);
+ *
+ * @param x0
+ *      Left coordinate of the crop window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the crop window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the crop window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A new grid of the cropped size containing the values extracted from the original grid.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
+ *      or if the crop window has a negative size.
+ */
+Grid Grid::crop(const int x0, const int y0, const int x1, const int y1) const
+{
+    if (x0 < 0 || x0 > x1 || y0 < 0 || y0 > y1 || x1 > get_width() || y1 > get_height())
+    {
+        throw std::out_of_range("crop out of bounds.");
+    }
+    else if (layout == Layout::TILED)
+    {
+        //gather each row from its tiles, shift the window down to bit 0, and scatter it
+        Grid cropped(x1 - x0, y1 - y0, Layout::TILED, *arena);
+        std::vector<std::uint64_t> row(words_per_row);
+        std::vector<std::uint64_t> cropped_row(cropped.words_per_row);
+        for (int y = 0; y < y1 - y0; y++)
+        {
+            read_row(y0 + y, row.data());
+            std::fill(cropped_row.begin(), cropped_row.end(), 0);
+            cropped.alive_cells += copy_bits(cropped_row.data(), 0, row.data(), x0, x1 - x0);
+            cropped.write_row(y, cropped_row.data());
+        }
+        cropped.expand_live_box(0, 0, x1 - x0, y1 - y0);
+        cropped.live_box_tight = false;
+        cropped.zobrist_valid = false;
+        return cropped;
+    }
+    else
+    {
+        //copy the rows of a view of the crop window
+        return Grid(view(x0, y0, x1, y1), *arena);
+    }
+}
+
+/**
+ * Grid::view(x0, y0, x1, y1)
+ *
+ * Make a read-only view of a window of the grid without copying any cells, the zero-copy form of Grid::crop.
+ * The view spans the range [x0, x1) by [y0, y1) and is only valid while the grid is alive and not resized.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Print the centre 2x2 of the grid without copying it
+ *      std::cout << grid.view(1, 1, 3, 3) << std::endl;
+ *
+ * @param x0
+ *      Left coordinate of the window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A view of the window.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
+ *      or if the window has a negative size.
+ */
+GridView Grid::view(const int x0, const int y0, const int x1, const int y1) const
+{
+    return GridView(*this).crop(x0, y0, x1, y1);
+}
+
+/**
+ * Grid::merge(other, x0, y0, alive_only = false)
+ *
+ * Merge two grids together by overlaying the other on the current grid at the desired location.
+ * By default merging overwrites all cells within the merge reason to be the value from the other grid.
+ * The other grid is taken as a GridView so it is never copied, unless it is a view of this grid.
+ *
+ * Conditionally if alive_only = true perform the merge such that only alive cells are updated.
+ *      - If a cell is originally dead it can be updated to be alive from the merge.
+ *      - If a cell is originally alive it cannot be updated to be dead from the merge.
+ *
+ * @example
+ *
+ *      // Make two grids
+ *      Grid x(2, 2), y(4, 4);
+ *
+ *      // Overlay x as the upper left 2x2 in y
+ *      y.merge(x, 0, 0);
+ *
+ *      // Overlay x as the bottom right 2x2 in y, reading only alive cells from x
+ *      y.merge(x, 2, 2, true);
+ *
+ * @param other
+ *      The other grid, or a view of part of a grid, to merge into the current grid.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive but does not explicitly set
+ *      dead cells, allowing whatever value was already there to persist. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void Grid::merge(const GridView &other, const int x0, const int y0, const bool alive_only)
+{
+
+    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
+    {
+        throw std::out_of_range("merge out of bounds.");
+    }
+    else if (other.get_height() > 0 && !std::less<const std::uint64_t *>()(other.get_row(0), cell_words)
+             && std::less<const std::uint64_t *>()(other.get_row(0), cell_words + capacity))
+    {
+        //the view looks into this grid so rows could be overwritten before they are read
+        merge(Grid(other, *arena), x0, y0, alive_only);
+    }
+    else if (layout == Layout::TILED)
+    {
+        expand_live_box(x0, y0, x0 + other.get_width(), y0 + other.get_height());
+        live_box_tight = false;
+        zobrist_valid = false;
+
+        //gather each row from its tiles, copy the other row in, and scatter it back
+        std::vector<std::uint64_t> row(words_per_row);
+        for (int y = y0; y < y0 + other.get_height(); y++)
+        {
+            read_row(y, row.data());
+            alive_cells += copy_bits(row.data(), x0, other.get_row(y - y0), other.get_offset(),
+                                     other.get_width(), alive_only);
+            write_row(y, row.data());
+        }
+    }
+    else
+    {
+        expand_live_box(x0, y0, x0 + other.get_width(), y0 + other.get_height());
+        live_box_tight = false;
+        zobrist_valid = false;
+
+        //copy each row of the other grid a word at a time,
+        //alive only merges OR the rows in so dead cells dont overwrite
+        for (int y = y0; y < y0 + other.get_height(); y++)
+        {
+            alive_cells += copy_bits(cell_words + get_row_start(y), x0,
+                                     other.get_row(y - y0), other.get_offset(),
+                                     other.get_width(), alive_only);
+        }
+    }
+}
+
+/**
+ * Grid::merge(other, x0, y0, alive_only = false)
+ *
+ * Merge another grid into this one, as Grid::merge(view, x0, y0, alive_only).
+ * A tiled grid cannot be viewed, so it is converted to a row major copy first.
+ *
+ * @param other
+ *      The other grid to merge into the current grid.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void Grid::merge(const Grid &other, const int x0, const int y0, const bool alive_only)
+{
+    if (other.layout == Layout::TILED)
+    {
+        merge(GridView(other.to_layout(Layout::ROW_MAJOR)), x0, y0, alive_only);
+    }
+    else
+    {
+        merge(GridView(other), x0, y0, alive_only);
+    }
+}
+
+/**
+ * combine_row(op, dst, dst_bit, src, src_bit, count)
+ *
+ * Helper function to apply a CellOp to count cells of a packed row, choosing the operation once
+ * per row so the word loop inside combine_bits is specialised for it.
+ *
+ * @return
+ *      The change in the number of alive cells of the destination row.
+ */
+static long long combine_row(const CellOp op, std::uint64_t *dst, const std::size_t dst_bit,
+                             const std::uint64_t *src, const std::size_t src_bit, const std::size_t count)
+{
+    switch (op)
+    {
+    case CellOp::AND:
+        return combine_bits(dst, dst_bit, src, src_bit, count, [](std::uint64_t a, std::uint64_t b) { return a & b; });
+    case CellOp::OR:
+        return combine_bits(dst, dst_bit, src, src_bit, count, [](std::uint64_t a, std::uint64_t b) { return a | b; });
+    case CellOp::XOR:
+        return combine_bits(dst, dst_bit, src, src_bit, count, [](std::uint64_t a, std::uint64_t b) { return a ^ b; });
+    default:
+        return combine_bits(dst, dst_bit, src, src_bit, count, [](std::uint64_t a, std::uint64_t b) { return a & ~b; });
+    }
+}
+
+/**
+ * count_row(op, a, a_bit, b, b_bit, count)
+ *
+ * Helper function to count the alive cells a CellOp would produce over count cells of two packed rows.
+ *
+ * @return
+ *      The number of alive cells in the combination.
+ */
+static std::size_t count_row(const CellOp op, const std::uint64_t *a, const std::size_t a_bit,
+                             const std::uint64_t *b, const std::size_t b_bit, const std::size_t count)
+{
+    switch (op)
+    {
+    case CellOp::AND:
+        return count_combined_bits(a, a_bit, b, b_bit, count, [](std::uint64_t x, std::uint64_t y) { return x & y; });
+    case CellOp::OR:
+        return count_combined_bits(a, a_bit, b, b_bit, count, [](std::uint64_t x, std::uint64_t y) { return x | y; });
+    case CellOp::XOR:
+        return count_combined_bits(a, a_bit, b, b_bit, count, [](std::uint64_t x, std::uint64_t y) { return x ^ y; });
+    default:
+        return count_combined_bits(a, a_bit, b, b_bit, count, [](std::uint64_t x, std::uint64_t y) { return x & ~y; });
+    }
+}
+
+/**
+ * Grid::apply(op, other, x0 = 0, y0 = 0)
+ *
+ * Combine the cells of a view into this grid in place, a word at a time. The view is placed with
+ * its top left corner at x0,y0 and each covered cell becomes op(this cell, view cell), cells outside
+ * the view are untouched. Grid::merge with alive_only = true is the same as CellOp::OR.
+ *
+ * @example
+ *
+ *      // Keep only the cells of a world that are inside a mask
+ *      Grid state = world.get_state();
+ *      state.apply(CellOp::AND, mask);
+ *
+ *      // Turn on a stamp at 10,20 wherever it is alive, or toggle it with CellOp::XOR
+ *      state.apply(CellOp::OR, Zoo::glider(), 10, 20);
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The view to combine into the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @throws
+ *      std::out_of_range if the view being placed does not fit within the bounds of the current grid.
+ */
+void Grid::apply(const CellOp op, const GridView &other, const int x0, const int y0)
+{
+    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
+    {
+        throw std::out_of_range("apply out of bounds.");
+    }
+    else if (other.get_height() > 0 && !std::less<const std::uint64_t *>()(other.get_row(0), cell_words)
+             && std::less<const std::uint64_t *>()(other.get_row(0), cell_words + capacity))
+    {
+        //the view looks into this grid so rows could be overwritten before they are read
+        apply(op, Grid(other, *arena), x0, y0);
+    }
+    else
+    {
+        //AND and AND_NOT only kill cells, OR and XOR may bring any covered cell to life
+        if (op == CellOp::OR || op == CellOp::XOR)
+        {
+            expand_live_box(x0, y0, x0 + other.get_width(), y0 + other.get_height());
+        }
+        live_box_tight = false;
+        zobrist_valid = false;
+
+        //rows of a tiled grid are gathered from their tiles and scattered back after
+        std::vector<std::uint64_t> gathered(layout == Layout::TILED ? words_per_row : 0);
+        for (int y = y0; y < y0 + other.get_height(); y++)
+        {
+            std::uint64_t *row = cell_words + get_row_start(y);
+            if (layout == Layout::TILED)
+            {
+                read_row(y, gathered.data());
+                row = gathered.data();
+            }
+            alive_cells += combine_row(op, row, x0, other.get_row(y - y0), other.get_offset(), other.get_width());
+            if (layout == Layout::TILED)
+            {
+                write_row(y, row);
+            }
+        }
+    }
+}
+
+/**
+ * Grid::apply(op, other, x0 = 0, y0 = 0)
+ *
+ * Combine the cells of another grid into this one in place, as Grid::apply(op, view, x0, y0).
+ * A tiled grid cannot be viewed, so it is converted to a row major copy first.
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The grid to combine into the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @throws
+ *      std::out_of_range if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void Grid::apply(const CellOp op, const Grid &other, const int x0, const int y0)
+{
+    if (other.layout == Layout::TILED)
+    {
+        apply(op, GridView(other.to_layout(Layout::ROW_MAJOR)), x0, y0);
+    }
+    else
+    {
+        apply(op, GridView(other), x0, y0);
+    }
+}
+
+/**
+ * Grid::combine(op, other, x0 = 0, y0 = 0)
+ *
+ * Create a copy of the grid with the cells of a view combined into it, see Grid::apply.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Find the cells that changed in one generation
+ *      Grid before = world.get_state();
+ *      world.step();
+ *      Grid changed = world.get_state().combine(CellOp::XOR, before);
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The view to combine with the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @return
+ *      The combined grid.
+ *
+ * @throws
+ *      std::out_of_range if the view being placed does not fit within the bounds of the current grid.
+ */
+Grid Grid::combine(const CellOp op, const GridView &other, const int x0, const int y0) const
+{
+    Grid combined(*this);
+    combined.apply(op, other, x0, y0);
+    return combined;
+}
+
+/**
+ * Grid::combine(op, other, x0 = 0, y0 = 0)
+ *
+ * Create a copy of the grid with the cells of another grid combined into it, see Grid::apply.
+ * The function should be callable from a constant context.
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The grid to combine with the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @return
+ *      The combined grid.
+ *
+ * @throws
+ *      std::out_of_range if the other grid being placed does not fit within the bounds of the current grid.
+ */
+Grid Grid::combine(const CellOp op, const Grid &other, const int x0, const int y0) const
+{
+    Grid combined(*this);
+    combined.apply(op, other, x0, y0);
+    return combined;
+}
+
+/**
+ * Grid::count_cells(op, other, x0 = 0, y0 = 0)
+ *
+ * Count the alive cells op would produce over the cells covered by a view placed at x0,y0, without
+ * writing them anywhere. For a view the size of the grid that is the population of the whole
+ * combination, and CellOp::XOR counts the cells that differ.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Count the cells that changed in one generation
+ *      Grid before = world.get_state();
+ *      world.step();
+ *      std::uint64_t changes = world.get_state().count_cells(CellOp::XOR, before);
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The view to combine with the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the view. Defaults to 0.
+ *
+ * @return
+ *      The number of alive cells in the combination of the covered cells.
+ *
+ * @throws
+ *      std::out_of_range if the view being placed does not fit within the bounds of the current grid.
+ */
+std::uint64_t Grid::count_cells(const CellOp op, const GridView &other, const int x0, const int y0) const
+{
+    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
+    {
+        throw std::out_of_range("count_cells out of bounds.");
+    }
+
+    std::size_t count = 0;
+    std::vector<std::uint64_t> gathered(layout == Layout::TILED ? words_per_row : 0);
+    for (int y = y0; y < y0 + other.get_height(); y++)
+    {
+        const std::uint64_t *row = cell_words + get_row_start(y);
+        if (layout == Layout::TILED)
+        {
+            read_row(y, gathered.data());
+            row = gathered.data();
+        }
+        count += count_row(op, row, x0, other.get_row(y - y0), other.get_offset(), other.get_width());
+    }
+    return count;
+}
+
+/**
+ * Grid::count_cells(op, other, x0 = 0, y0 = 0)
+ *
+ * Count the alive cells op would produce over the cells covered by another grid placed at x0,y0,
+ * as Grid::count_cells(op, view, x0, y0).
+ * The function should be callable from a constant context.
+ *
+ * @param op
+ *      How to combine the cells.
+ *
+ * @param other
+ *      The grid to combine with the current grid.
+ *
+ * @param x0
+ *      Optional parameter. The x coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @param y0
+ *      Optional parameter. The y coordinate of where to place the top left corner of the other grid. Defaults to 0.
+ *
+ * @return
+ *      The number of alive cells in the combination of the covered cells.
+ *
+ * @throws
+ *      std::out_of_range if the other grid being placed does not fit within the bounds of the current grid.
+ */
+std::uint64_t Grid::count_cells(const CellOp op, const Grid &other, const int x0, const int y0) const
+{
+    if (other.layout == Layout::TILED)
+    {
+        return count_cells(op, GridView(other.to_layout(Layout::ROW_MAJOR)), x0, y0);
+    }
+    return count_cells(op, GridView(other), x0, y0);
+}
+
+/**
+ * Grid::rotate(rotation)
+ *
+ * Create a copy of the grid that is rotated by a multiple of 90 degrees.
+ * The rotation can be any integer, positive, negative, or 0.
+ * The function should take the same amount of time to execute for any valid integer input.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a 1x3 grid
+ *      Grid x(1,3);
+ *
+ *      // y is size 3x1
+ *      Grid y = x.rotate(1);
+ *
+ * @param _rotation
+ *      An positive or negative integer to rotate by in 90 intervals.
+ *
+ * @return
+ *      Returns a copy of the grid that has been rotated.
+ */
+Grid Grid::rotate(const int _rotation) const
+{
+
+    int number_of_rotations = ((_rotation % 4) + 4) % 4;
+
+    //90 degrees clockwise is a transpose then a mirror, 270 is a transpose
+    //then a vertical flip, and 180 is a mirror and a vertical flip
+    Grid new_grid = (number_of_rotations % 2 == 1) ? transpose() : Grid(*this);
+    if (number_of_rotations == 1 || number_of_rotations == 2)
+    {
+        new_grid.mirror_rows();
+    }
+    if (number_of_rotations == 2 || number_of_rotations == 3)
+    {
+        new_grid.reverse_rows();
+    }
+    new_grid.origin_x = 0;
+    new_grid.origin_y = 0;
+    return new_grid;
+}
+
+/**
+ * Grid::rotate_in_place(rotation)
+ *
+ * Rotate the grid itself by a multiple of 90 degrees, with the same result as Grid::rotate.
+ * Square grids, and any grid rotated by 180 degrees, are rotated without allocating, swapping
+ * 64x64 tiles across the diagonal. Other grids change shape so are replaced by a rotated copy.
+ *
+ * @example
+ *
+ *      // Make a square grid
+ *      Grid grid(1024, 1024);
+ *
+ *      // Rotate it 90 degrees clockwise without making a copy
+ *      grid.rotate_in_place(1);
+ *
+ * @param rotation
+ *      An positive or negative integer to rotate by in 90 intervals.
+ */
+void Grid::rotate_in_place(const int rotation)
+{
+    const int number_of_rotations = ((rotation % 4) + 4) % 4;
+    if (number_of_rotations % 2 == 1 && width != height)
+    {
+        *this = rotate(rotation);
+        return;
+    }
+
+    if (number_of_rotations % 2 == 1)
+    {
+        transpose_in_place();
+    }
+    if (number_of_rotations == 1 || number_of_rotations == 2)
+    {
+        mirror_rows();
+    }
+    if (number_of_rotations == 2 || number_of_rotations == 3)
+    {
+        reverse_rows();
+    }
+}
+
+/**
+ * Grid::transpose()
+ *
+ * Create a copy of the grid reflected across its main diagonal, so cell (x, y) moves to (y, x).
+ * Works on 64x64 tiles, each read as one word from each of 64 rows, transposed as a bit matrix,
+ * and written as one word to each of 64 rows, so both grids are walked in cache friendly order.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a 2x5 grid
+ *      Grid x(2, 5);
+ *
+ *      // y is size 5x2
+ *      Grid y = x.transpose();
+ *
+ * @return
+ *      Returns a transposed copy of the grid.
+ */
+Grid Grid::transpose() const
+{
+    Grid transposed = (layout == Layout::TILED) ? Grid(height, width, Layout::TILED, *arena)
+                                                : Grid(height, width, halo, *arena);
+    std::uint64_t block[64];
+    for (unsigned int tile_y = 0; tile_y < (height + 63) / 64; tile_y++)
+    {
+        for (unsigned int tile_x = 0; tile_x < words_per_row; tile_x++)
+        {
+            load_block(block, tile_y, tile_x);
+            transpose_block(block);
+            transposed.store_block(block, tile_x, tile_y);
+        }
+    }
+    //moving cells around does not change how many are alive
+    transposed.alive_cells = alive_cells;
+    transposed.alive_cells_valid = alive_cells_valid;
+    transposed.live_box = BoundingBox{live_box.y0, live_box.x0, live_box.y1, live_box.x1};
+    transposed.live_box_tight = live_box_tight;
+    transposed.zobrist_valid = false;
+    return transposed;
+}
+
+/**
+ * Grid::flip_horizontal()
+ *
+ * Create a copy of the grid mirrored left to right, so cell (x, y) moves to (width - 1 - x, y).
+ * Rows are mirrored a word at a time with a bit reversal.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      Returns a mirrored copy of the grid.
+ */
+Grid Grid::flip_horizontal() const
+{
+    Grid flipped(*this);
+    flipped.mirror_rows();
+    return flipped;
+}
+
+/**
+ * Grid::flip_vertical()
+ *
+ * Create a copy of the grid flipped top to bottom, so cell (x, y) moves to (x, height - 1 - y).
+ * Whole rows are swapped.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      Returns a flipped copy of the grid.
+ */
+Grid Grid::flip_vertical() const
+{
+    Grid flipped(*this);
+    flipped.reverse_rows();
+    return flipped;
+}
+
+/**
+ * Grid::load_block(block, tile_y, tile_x)
+ *
+ * Private helper function to read a 64x64 tile, word tile_x of rows tile_y * 64 to tile_y * 64 + 63.
+ * Rows past the height and cells past the width (including any right halo) are read as dead.
+ *
+ * @param block
+ *      The 64 words to fill, one per row of the tile.
+ *
+ * @param tile_y
+ *      The row of tiles to read from.
+ *
+ * @param tile_x
+ *      The column of tiles to read from, which is also the word of each row.
+ */
+void Grid::load_block(std::uint64_t block[64], const unsigned int tile_y, const unsigned int tile_x) const
+{
+    const std::uint64_t mask = ((tile_x + 1) * 64 <= width) ? ~std::uint64_t(0) : get_mask(width) - 1;
+    for (unsigned int r = 0; r < 64; r++)
+    {
+        const unsigned int y = tile_y * 64 + r;
+        block[r] = (y < height) ? (cell_words[get_index(tile_x * 64, y)] & mask) : 0;
+    }
+}
+
+/**
+ * Grid::store_block(block, tile_y, tile_x)
+ *
+ * Private helper function to write a 64x64 tile, word tile_x of rows tile_y * 64 to tile_y * 64 + 63.
+ * Rows past the height are skipped, the caller must keep bits past the width 0.
+ * Does not update the alive cell count.
+ *
+ * @param block
+ *      The 64 words to write, one per row of the tile.
+ *
+ * @param tile_y
+ *      The row of tiles to write to.
+ *
+ * @param tile_x
+ *      The column of tiles to write to, which is also the word of each row.
+ */
+void Grid::store_block(const std::uint64_t block[64], const unsigned int tile_y, const unsigned int tile_x)
+{
+    for (unsigned int r = 0; r < 64 && tile_y * 64 + r < height; r++)
+    {
+        cell_words[get_index(tile_x * 64, tile_y * 64 + r)] = block[r];
+    }
+}
+
+/**
+ * Grid::transpose_in_place()
+ *
+ * Private helper function to transpose a square grid in place. Tiles on the diagonal are
+ * transposed where they are, every other pair of tiles is transposed and swapped.
+ */
+void Grid::transpose_in_place()
+{
+    std::uint64_t block[64];
+    std::uint64_t mirror[64];
+    for (unsigned int tile_y = 0; tile_y < words_per_row; tile_y++)
+    {
+        for (unsigned int tile_x = tile_y; tile_x < words_per_row; tile_x++)
+        {
+            load_block(block, tile_y, tile_x);
+            transpose_block(block);
+            if (tile_x != tile_y)
+            {
+                load_block(mirror, tile_x, tile_y);
+                transpose_block(mirror);
+                store_block(mirror, tile_y, tile_x);
+            }
+            store_block(block, tile_x, tile_y);
+        }
+    }
+    live_box = BoundingBox{live_box.y0, live_box.x0, live_box.y1, live_box.x1};
+    zobrist_valid = false;
+}
+
+/**
+ * Grid::mirror_rows()
+ *
+ * Private helper function to mirror every row left to right in place. Each row is bit reversed
+ * a word at a time into a scratch row, reversing the word order too, which leaves the cells
+ * shifted up by the unused bits of the last word, then shifted back down into place.
+ * Rows of a tiled grid are gathered into a scratch row first and scattered back after.
+ */
+void Grid::mirror_rows()
+{
+    std::vector<std::uint64_t> reversed(words_per_row);
+    std::vector<std::uint64_t> gathered(layout == Layout::TILED ? words_per_row : 0);
+    const std::size_t unused_bits = std::size_t(words_per_row) * 64 - width;
+    for (int y = 0; y < get_height(); y++)
+    {
+        std::uint64_t *row = cell_words + get_row_start(y);
+        if (layout == Layout::TILED)
+        {
+            read_row(y, gathered.data());
+            row = gathered.data();
+        }
+        for (unsigned int i = 0; i < words_per_row; i++)
+        {
+            reversed[words_per_row - 1 - i] = reverse_bits(row[i]);
+        }
+        copy_bits(row, 0, reversed.data(), unused_bits, width);
+        if (layout == Layout::TILED)
+        {
+            write_row(y, row);
+        }
+    }
+    if (live_box.x0 < live_box.x1)
+    {
+        live_box = BoundingBox{int(width) - live_box.x1, live_box.y0, int(width) - live_box.x0, live_box.y1};
+    }
+    zobrist_valid = false;
+}
+
+/**
+ * Grid::reverse_rows()
+ *
+ * Private helper function to flip the grid top to bottom in place by swapping whole rows.
+ */
+void Grid::reverse_rows()
+{
+    for (unsigned int y = 0; y < height / 2; y++)
+    {
+        for (unsigned int i = 0; i < words_per_row; i++)
+        {
+            std::swap(cell_words[get_index(i * 64, y)], cell_words[get_index(i * 64, height - 1 - y)]);
+        }
+    }
+    if (live_box.y0 < live_box.y1)
+    {
+        live_box = BoundingBox{live_box.x0, int(height) - live_box.y1, live_box.x1, int(height) - live_box.y0};
+    }
+    zobrist_valid = false;
+}
+
+/**
+ * Grid::read_row(y, dst)
+ *
+ * Private helper function to gather the words of a row into a contiguous buffer, for either layout.
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @param dst
+ *      The buffer to fill, Grid::get_words_per_row() words long.
+ */
+void Grid::read_row(const int y, std::uint64_t *dst) const
+{
+    for (unsigned int i = 0; i < words_per_row; i++)
+    {
+        dst[i] = cell_words[get_index(i * 64, y)];
+    }
+}
+
+/**
+ * Grid::write_row(y, src)
+ *
+ * Private helper function to scatter a contiguous buffer into the words of a row, for either layout.
+ * Does not update the alive cell count.
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @param src
+ *      The words to write, Grid::get_words_per_row() words long with bits past the width 0.
+ */
+void Grid::write_row(const int y, const std::uint64_t *src)
+{
+    for (unsigned int i = 0; i < words_per_row; i++)
+    {
+        cell_words[get_index(i * 64, y)] = src[i];
+    }
+}
+
+/**
+ * Grid::get_layout()
+ *
+ * Gets the order the grid stores its packed words in.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      Layout::ROW_MAJOR or Layout::TILED.
+ */
+Layout Grid::get_layout() const
+{
+    return layout;
+}
+
+/**
+ * Grid::to_layout(layout)
+ *
+ * Create a copy of the grid stored in the desired layout. Cells are moved a 64x64 tile at a time,
+ * a word per row, so conversion is a single pass over both buffers. Converting to Layout::TILED
+ * drops any halo, converting to Layout::ROW_MAJOR gives a grid without a halo.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a tiled grid
+ *      Grid tiled(1000, 1000, Layout::TILED);
+ *
+ *      // Save it, which needs a row major grid
+ *      Zoo::save_binary("grid.bgol", tiled.to_layout(Layout::ROW_MAJOR));
+ *
+ * @param layout
+ *      The layout of the copy.
+ *
+ * @return
+ *      A copy of the grid in the desired layout.
+ */
+Grid Grid::to_layout(const Layout layout) const
+{
+    Grid converted(width, height, layout, *arena);
+    std::uint64_t block[64];
+    for (unsigned int tile_y = 0; tile_y < (height + 63) / 64; tile_y++)
+    {
+        for (unsigned int tile_x = 0; tile_x < words_per_row; tile_x++)
+        {
+            load_block(block, tile_y, tile_x);
+            converted.store_block(block, tile_y, tile_x);
+        }
+    }
+    converted.origin_x = origin_x;
+    converted.origin_y = origin_y;
+    converted.alive_cells = alive_cells;
+    converted.alive_cells_valid = alive_cells_valid;
+    converted.live_box = live_box;
+    converted.live_box_tight = live_box_tight;
+    converted.zobrist_hash = zobrist_hash;
+    converted.zobrist_valid = zobrist_valid;
+    converted.zobrist_tracking = zobrist_tracking;
+    return converted;
+}
+
+/**
+ * GridView::GridView(grid)
+ *
+ * Construct a view of all the cells of a grid. Deliberately not explicit, so a Grid can be passed
+ * anywhere a GridView is expected without copying it.
+ *
+ * @example
  *
- * @param x
- *      The x coordinate of the cell to access.
+ *      // Make a grid
+ *      Grid grid(4, 4);
  *
- * @param y
- *      The y coordinate of the cell to access.
+ *      // View the whole grid
+ *      GridView view = grid;
  *
- * @return
- *      A modifiable reference to the desired cell.
+ * @param grid
+ *      The grid to view, which must outlive the view.
  *
  * @throws
- *      std::runtime_error or sub-class if x,y is not a valid coordinate within the grid.
+ *      std::invalid_argument if the grid is Layout::TILED, its rows are not contiguous.
  */
-Cell &Grid::operator()(const int x, const int y)
+GridView::GridView(const Grid &grid)
+    : words(grid.get_row(0)), width(grid.get_width()), height(grid.get_height()),
+      stride(grid.get_stride()), offset(0)
 {
-    if (x >= get_width() || y >= get_height() || x < 0 || y < 0)
-    {
-        throw std::runtime_error("Grid::operator() out of bounds.");
-    }
-    else
+    if (grid.get_layout() == Layout::TILED)
     {
-        Cell &value = cell_grid.at(get_index(x, y));
-        return value;
+        throw std::invalid_argument("tiled grids cannot be viewed, convert them with to_layout.");
     }
 }
 
 /**
- * Grid::operator()(x, y)
+ * GridView::GridView(words, width, height, stride, offset)
  *
- * Gets a read-only reference to the value at the desired coordinate.
- * The operator should be callable from a constant context.
- * Should be implemented by invoking Grid::get_index(x, y).
+ * Construct a view of packed cells anywhere in memory, laid out like the rows of a Grid.
  *
- * @example
+ * @param words
+ *      The word holding cell (0, 0).
  *
- *      // Make a grid
- *      Grid grid(4, 4);
+ * @param width
+ *      The width of the view.
  *
- *      // Constant reference to a grid (does not make a copy)
- *      const Grid &read_only_grid = grid;
+ * @param height
+ *      The height of the view.
  *
- *      // Get access to read a cell at coordinate (1, 2)
- *      Cell cell = read_only_grid(1, 2);
+ * @param stride
+ *      The number of words between the starts of two rows.
  *
- * @param x
- *      The x coordinate of the cell to access.
+ * @param offset
+ *      The bit of the first word holding cell (0, 0), from 0 to 63.
+ */
+GridView::GridView(const std::uint64_t *words, const unsigned int width, const unsigned int height,
+                   const unsigned int stride, const unsigned int offset)
+    : words(words), width(width), height(height), stride(stride), offset(offset)
+{
+}
+
+/**
+ * GridView::get_width()
  *
- * @param y
- *      The y coordinate of the cell to access.
+ * Gets the width of the view.
  *
  * @return
- *      A read-only reference to the desired cell.
+ *      The width of the view.
+ */
+int GridView::get_width() const
+{
+    return width;
+}
+
+/**
+ * GridView::get_height()
  *
- * @throws
- *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ * Gets the height of the view.
+ *
+ * @return
+ *      The height of the view.
  */
-const Cell &Grid::operator()(const int x, const int y) const
+int GridView::get_height() const
 {
-    if (x >= get_width() || y >= get_height() || x < 0 || y < 0)
-    {
-        throw std::runtime_error("Grid::operator() out of bounds.");
-    }
-    else
-    {
-        const Cell &value = cell_grid.at(get_index(x, y));
-        return value;
-    }
-   
+    return height;
 }
+
 /**
- * Grid::crop(x0, y0, x1, y1)
+ * GridView::get_total_cells()
  *
- * Extract a sub-grid from a Grid.
- * The cropped grid spans the range [x0, x1) by [y0, y1) in the original grid.
- * The function should be callable from a constant context.
+ * Gets the total number of cells in the view.
  *
- * @example
+ * @return
+ *      The number of total cells.
+ */
+std::uint64_t GridView::get_total_cells() const
+{
+    return std::uint64_t(width) * height;
+}
+
+/**
+ * GridView::get_alive_cells()
  *
- *      // Make a grid
- *      Grid y(4, 4);
+ * Counts how many cells in the view are alive, with a popcount over each row 64 cells at a time.
  *
- *      // Crop the centre 2x2 in y, trimming a 1 cell border off all sides
- *      Grid x = y.crop(x, 1, 1, 3, 3);
+ * @return
+ *      The number of alive cells.
+ */
+std::uint64_t GridView::get_alive_cells() const
+{
+    std::uint64_t count = 0;
+    for (int y = 0; y < get_height(); y++)
+    {
+        for (unsigned int x = 0; x < width; x += 64)
+        {
+            count += count_bits(read_bits(get_row(y), offset + x, std::min(64u, width - x)));
+        }
+    }
+    return count;
+}
+
+/**
+ * GridView::get_dead_cells()
  *
- * @param x0
- *      Left coordinate of the crop window on x-axis.
+ * Counts how many cells in the view are dead.
  *
- * @param y0
- *      Top coordinate of the crop window on y-axis.
+ * @return
+ *      The number of dead cells.
+ */
+std::uint64_t GridView::get_dead_cells() const
+{
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * GridView::get(x, y)
  *
- * @param x1
- *      Right coordinate of the crop window on x-axis (1 greater than the largest index).
+ * Returns the value of the cell at the desired coordinate of the view.
  *
- * @param y1
- *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
  *
  * @return
- *      A new grid of the cropped size containing the values extracted from the original grid.
+ *      The value of the desired cell.
  *
  * @throws
- *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
- *      or if the crop window has a negative size.
+ *      std::exception or sub-class if x,y is not a valid coordinate within the view.
  */
-Grid Grid::crop(const int x0, const int y0, const int x1, const int y1) const
+Cell GridView::get(const int x, const int y) const
 {
-    if (x0 < 0 || x0 > x1 || y0 < 0 || y0 > y1 || x1 > get_width() || y1 > get_height())
+    if (x >= get_width() || x < 0 || y >= get_height() || y < 0)
     {
-        throw std::out_of_range("crop out of bounds.");
+        throw std::out_of_range("get is out of bounds.");
     }
     else
     {
-        std::vector<Cell> temp;
-        unsigned int diffx = x1 - x0;
-        unsigned int diffy = y1 - y0;
-        Grid newGrid = Grid(diffx, diffy);
-        //loop crop coordinates and pushback value
-        for (int y = y0; y < y1; y++)
-        {
-            for (int x = x0; x < x1; x++)
-            {
-                temp.push_back(get(x, y));
-            }
-        }
-
-        newGrid.cell_grid = temp;
-        return newGrid;
+        return get_unchecked(x, y);
     }
 }
 
 /**
- * Grid::merge(other, x0, y0, alive_only = false)
+ * GridView::get_unchecked(x, y)
  *
- * Merge two grids together by overlaying the other on the current grid at the desired location.
- * By default merging overwrites all cells within the merge reason to be the value from the other grid.
+ * Returns the value of the cell at the desired coordinate of the view without any bounds checking.
  *
- * Conditionally if alive_only = true perform the merge such that only alive cells are updated.
- *      - If a cell is originally dead it can be updated to be alive from the merge.
- *      - If a cell is originally alive it cannot be updated to be dead from the merge.
+ * @param x
+ *      The x coordinate of the cell, must be in [0, width).
  *
- * @example
+ * @param y
+ *      The y coordinate of the cell, must be in [0, height).
  *
- *      // Make two grids
- *      Grid x(2, 2), y(4, 4);
+ * @return
+ *      The value of the desired cell. The result is undefined if x,y is not a valid coordinate.
+ */
+Cell GridView::get_unchecked(const int x, const int y) const noexcept
+{
+    const unsigned int bit = offset + x;
+    return ((get_row(y)[bit / 64] >> (bit % 64)) & 1) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * GridView::get_stride()
  *
- *      // Overlay x as the upper left 2x2 in y
- *      y.merge(x, 0, 0);
+ * Gets the number of packed words between the starts of two rows of the view.
  *
- *      // Overlay x as the bottom right 2x2 in y, reading only alive cells from x
- *      y.merge(x, 2, 2, true);
+ * @return
+ *      The row stride in std::uint64_t words.
+ */
+unsigned int GridView::get_stride() const noexcept
+{
+    return stride;
+}
+
+/**
+ * GridView::get_offset()
  *
- * @param other
- *      The other grid to merge into the current grid.
+ * Gets the bit of the first word of each row that holds the first cell of the view.
+ * Cell x of a row is bit ((offset + x) % 64) of word ((offset + x) / 64).
  *
- * @param x0
- *      The x coordinate of where to place the top left corner of the other grid.
+ * @return
+ *      The bit offset, from 0 to 63.
+ */
+unsigned int GridView::get_offset() const noexcept
+{
+    return offset;
+}
+
+/**
+ * GridView::get_row(y)
  *
- * @param y0
- *      The y coordinate of where to place the top left corner of the other grid.
+ * Gets a read-only pointer to the word holding the first cell of a row of the view.
  *
- * @param alive_only
- *      Optional parameter. If true then merging only sets alive cells to alive but does not explicitly set
- *      dead cells, allowing whatever value was already there to persist. Defaults to false.
+ * @param y
+ *      The y coordinate of the row, must be in [0, height).
  *
- * @throws
- *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ * @return
+ *      A pointer to the first word of the row.
  */
-void Grid::merge(const Grid other, const int x0, const int y0, const bool alive_only)
+const std::uint64_t *GridView::get_row(const int y) const noexcept
 {
-
-    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
-    {
-        throw std::out_of_range("merge out of bounds.");
-    }
-    else
-    {
-        //loop through start of new grid to end
-        for (int y = y0; y < y0 + other.get_height(); y++)
-        {
-            for (int x = x0; x < x0 + other.get_width(); x++)
-            {
-                if (alive_only == true)
-                {
-                    //if alive set alive otherwise set it to others value
-                    if (other.get(x - x0, y - y0) == Cell::ALIVE)
-                    {
-                        set(x, y, Cell::ALIVE);
-                    }
-                }
-                else
-                {
-                    set(x, y, other.get(x - x0, y - y0));
-                }
-            }
-        }
-    }
+    return words + std::size_t(stride) * y;
 }
 
 /**
- * Grid::rotate(rotation)
+ * GridView::crop(x0, y0, x1, y1)
  *
- * Create a copy of the grid that is rotated by a multiple of 90 degrees.
- * The rotation can be any integer, positive, negative, or 0.
- * The function should take the same amount of time to execute for any valid integer input.
- * The function should be callable from a constant context.
+ * Narrow the view to a window of itself, without copying any cells.
+ * The new view spans the range [x0, x1) by [y0, y1) of this view.
  *
  * @example
  *
- *      // Make a 1x3 grid
- *      Grid x(1,3);
+ *      // Make a grid
+ *      Grid grid(8, 8);
  *
- *      // y is size 3x1
- *      Grid y = x.rotate(1);
+ *      // View the centre 4x4, then the centre 2x2 of that
+ *      GridView centre = grid.view(2, 2, 6, 6).crop(1, 1, 3, 3);
  *
- * @param _rotation
- *      An positive or negative integer to rotate by in 90 intervals.
+ * @param x0
+ *      Left coordinate of the window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the window on y-axis (1 greater than the largest index).
  *
  * @return
- *      Returns a copy of the grid that has been rotated.
+ *      A view of the window.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the view
+ *      or if the window has a negative size.
  */
-Grid Grid::rotate(const int _rotation) const
+GridView GridView::crop(const int x0, const int y0, const int x1, const int y1) const
 {
-
-    int number_of_rotations = ((_rotation % 4) + 4) % 4;
-    int new_width;
-    int new_height;
-
-    //switch width and height if 90 or 270 degrees
-    if (number_of_rotations == 1 || number_of_rotations == 3)
-    {       
-        new_width = get_height();
-        new_height = get_width();
-    }
-    else
+    if (x0 < 0 || x0 > x1 || y0 < 0 || y0 > y1 || x1 > get_width() || y1 > get_height())
     {
-        //360 or 0 degrees
-        //dont switch
-        new_width = get_width();
-        new_height = get_height();
+        throw std::out_of_range("crop out of bounds.");
     }
-
-    Grid new_grid = Grid(new_width, new_height);
-
-    //loop through every cell of newgrid
-    for (int y = 0; y < new_height; y++)
+    else
     {
-        for (int x = 0; x < new_width; x++)
-        {
-            //make a cell to hold rotated value
-            Cell rotated_cell;
-            if (number_of_rotations == 0)
-            {
-                //do nothing if no rotation
-                rotated_cell = operator()(x, y);
-            }
-            else if (number_of_rotations == 1)
-            {
-                //(x,y)->(y,-x)
-                rotated_cell = operator()(y,new_width-1 -x);
-            }
-            else if (number_of_rotations == 2)
-            {
-                //(x,y)->(-y,-x)
-                rotated_cell = operator()(new_width-1 -x, new_height -1 -y);
-            }
-            else if (number_of_rotations == 3)
-            {
-                //(x,y)->(y,x)
-                rotated_cell = operator()(new_height-1 -y, x);
-            }     
-            new_grid(x,y)=rotated_cell; 
-        }
-
+        const unsigned int bit = offset + x0;
+        return GridView(get_row(y0) + bit / 64, x1 - x0, y1 - y0, stride, bit % 64);
     }
-    return new_grid;
 }
 
 /**
@@ -774,43 +3394,40 @@ Grid Grid::rotate(const int _rotation) const
 
 std::ostream &operator<<(std::ostream &os, const Grid &grid)
 {
-    //first line
-    os << "+";
-    for (int i = 0; i < (grid.get_width()); i++)
+    if (grid.get_layout() == Layout::TILED)
     {
-        os << "-";
+        return os << GridView(grid.to_layout(Layout::ROW_MAJOR));
     }
-    os << "+";
-    os << "\n";
-
-    //main body
-    for (int y = 0; y < grid.get_height(); y++)
-    {
-        os << "|";
-        for (int x = 0; x < grid.get_width(); x++)
-        {
-
-            if (grid.get(x, y) == Cell::ALIVE)
-            {
-                os << '#';
-            }
-            else
-            {
-                os << ' ';
-            }
-        }
-        os << "|";
-        os << "\n";
-    }
-
-    //final line
-    os << "+";
-    for (int i = 0; i < (grid.get_width()); i++)
-    {
-        os << "-";
-    }
-    os << "+";
-    os << "\n";
+    return os << GridView(grid);
+}
 
-    return os;
+/**
+ * operator<<(output_stream, view)
+ *
+ * Serializes the cells seen through a view to an ascii output stream, in the same format as a Grid.
+ * The frame is built in a reusable buffer by a Renderer and emitted with a single write,
+ * use a Renderer directly to print a viewport or a downsampled frame.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(8, 8);
+ *
+ *      // Print the top left 4x4 of the grid without copying it
+ *      std::cout << grid.view(0, 0, 4, 4) << std::endl;
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param grid
+ *      A view of the cells to be printed.
+ *
+ * @return
+ *      Returns a reference to the output stream to enable operator chaining.
+ */
+std::ostream &operator<<(std::ostream &os, const GridView &grid)
+{
+    //one renderer per thread so the frame buffer is reused between prints
+    static thread_local Renderer renderer;
+    return renderer.write(os, grid);
 }
\ No newline at end of file
@@ -12,8 +12,9 @@
 
 // Add the minimal number of includes you need in order to declare the class.
 // #include ...
-#include <vector>
 #include <ostream>
+#include <cstdint>
+#include "arena.h"
 /**
  * A Cell is a char limited to two named values for Cell::DEAD and Cell::ALIVE.
  */
@@ -23,47 +24,253 @@ enum Cell : char
     ALIVE = '#'
 };
 
+/**
+ * A Layout selects the order a Grid stores its packed words in.
+ *      - Layout::ROW_MAJOR stores each row as consecutive words, one row after another.
+ *      - Layout::TILED stores each 64x64 tile as 64 consecutive words, one tile after another.
+ */
+enum class Layout : char
+{
+    ROW_MAJOR,
+    TILED
+};
+
+/**
+ * A CellOp selects how Grid::apply combines the cells of another grid into a grid.
+ *      - CellOp::AND keeps cells alive in both, masking one grid with another.
+ *      - CellOp::OR makes cells alive in either, layering one grid onto another.
+ *      - CellOp::XOR keeps cells alive in exactly one, the cells that changed between two generations.
+ *      - CellOp::AND_NOT keeps cells alive in this grid but not the other, erasing one grid with another.
+ */
+enum class CellOp : char
+{
+    AND,
+    OR,
+    XOR,
+    AND_NOT
+};
+
+/**
+ * A BoundingBox is the range [x0, x1) by [y0, y1) of a grid, empty when x0 == x1 or y0 == y1.
+ */
+struct BoundingBox
+{
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+/**
+ * A GridDelta collects the changes a run of writes makes to the maintained counts of a Grid,
+ * so threads writing disjoint rows can each keep their own and merge them into the grid afterwards.
+ * Start from GridDelta{} and pass to Grid::merge_delta once the writes are done.
+ */
+struct GridDelta
+{
+    long long alive_cells;
+    BoundingBox born;
+    std::uint64_t zobrist_hash;
+    bool changed;
+    bool killed;
+};
+
+class GridView;
+
 /**
  * Declare the structure of the Grid class for representing a 2d grid of cells.
  */
 class Grid
 {
+public:
+    /**
+     * Cells are packed 64 to a word, so a modifiable cell is represented by a proxy
+     * to its word and bit rather than a Cell reference.
+     */
+    class CellReference
+    {
+    private:
+        std::uint64_t &word;
+        std::uint64_t mask;
+        std::uint64_t &alive_cells;
+
+    public:
+        CellReference(std::uint64_t &word, const std::uint64_t mask, std::uint64_t &alive_cells);
+
+        operator Cell() const;
+        CellReference &operator=(const Cell value);
+        CellReference &operator=(const CellReference &other);
+    };
+
 private:
     unsigned int width;
     unsigned int height;
-    std::vector<Cell> cell_grid;
-    unsigned int get_index(const unsigned int x, const unsigned int y) const;
+    unsigned int halo;
+    Layout layout;
+    unsigned int words_per_row;
+    unsigned int stride;
+    int origin_x;
+    int origin_y;
+    GridArena *arena;
+    std::uint64_t *cell_words;
+    std::size_t capacity;
+    mutable std::uint64_t alive_cells;
+    mutable bool alive_cells_valid;
+    mutable BoundingBox live_box;
+    mutable bool live_box_tight;
+    mutable std::uint64_t zobrist_hash;
+    mutable bool zobrist_valid;
+    bool zobrist_tracking;
+    static unsigned int get_guard_words(const unsigned int halo);
+    static unsigned int get_stride(const unsigned int width, const unsigned int halo);
+    std::size_t get_storage_words() const;
+    std::size_t get_row_start(const int y) const;
+    std::size_t get_index(const int x, const int y) const;
+    static std::uint64_t get_mask(const int x);
+    std::uint64_t count_alive_cells() const;
+    void refresh_row_halo(const int y, const bool toroidal);
+    void refresh_halo_rows(const bool toroidal, const bool top, const bool bottom);
+    void expand_live_box(const int x0, const int y0, const int x1, const int y1);
+    BoundingBox find_live_box() const;
+    static std::uint64_t get_zobrist_key(const int x, const int y);
+    std::uint64_t find_zobrist_hash() const;
+    std::uint64_t read_cells(const int x, const int y, const unsigned int count) const;
+    std::uint64_t hash_window(const BoundingBox &box) const;
+    void relayout(const unsigned int new_width, const unsigned int new_height,
+                  const unsigned int shift_x, const unsigned int shift_y);
+    void load_block(std::uint64_t block[64], const unsigned int tile_y, const unsigned int tile_x) const;
+    void store_block(const std::uint64_t block[64], const unsigned int tile_y, const unsigned int tile_x);
+    void transpose_in_place();
+    void mirror_rows();
+    void reverse_rows();
+    void read_row(const int y, std::uint64_t *dst) const;
+    void write_row(const int y, const std::uint64_t *src);
 
 public:
     Grid();
     explicit Grid(const unsigned int square_size);
-    Grid(const unsigned int width, const unsigned int height);
+    Grid(const unsigned int width, const unsigned int height, const unsigned int halo = 0,
+         GridArena &arena = GridArena::get_default());
+    Grid(const unsigned int width, const unsigned int height, const Layout layout,
+         GridArena &arena = GridArena::get_default());
+    explicit Grid(const GridView &view, GridArena &arena = GridArena::get_default());
+    Grid(const Grid &other);
+    Grid(Grid &&other) noexcept;
+    Grid &operator=(const Grid &other);
+    Grid &operator=(Grid &&other) noexcept;
     ~Grid();
 
     int get_width() const;
     int get_height() const;
-    unsigned int get_total_cells() const;
-    unsigned int get_alive_cells() const;
-    unsigned int get_dead_cells() const;
+    std::uint64_t get_total_cells() const;
+    std::uint64_t get_alive_cells() const;
+    std::uint64_t get_dead_cells() const;
+
+    BoundingBox get_live_box() const;
+    GridView live_view() const;
+    void clear();
+
+    std::uint64_t hash() const;
+    std::uint64_t hash_live() const;
+    std::uint64_t get_zobrist_hash() const;
+    bool get_zobrist_tracking() const;
+    void set_zobrist_tracking(const bool enabled);
+
+    bool operator==(const Grid &other) const;
+    bool operator!=(const Grid &other) const;
 
     void resize(const unsigned int square_size);
     void resize(const unsigned int width, const unsigned int height);
+    void grow(const unsigned int left, const unsigned int top, const unsigned int right, const unsigned int bottom);
+
+    int get_origin_x() const;
+    int get_origin_y() const;
 
     Cell get(const int x, const int y) const;
 
     void set(const int x, const int y, Cell value);
 
-    Cell &operator()(const int x, const int y);
-    const Cell &operator()(const int x, const int y) const;
+    Cell get_unchecked(const int x, const int y) const noexcept;
+    void set_unchecked(const int x, const int y, const Cell value) noexcept;
+    void set_word_unchecked(const int x, const int y, const std::uint64_t word) noexcept;
+    void set_words_unchecked(const int x, const int y, const std::uint64_t *words, const unsigned int count) noexcept;
+    void set_words_unchecked(const int x, const int y, const std::uint64_t *words, const unsigned int count,
+                             GridDelta &delta) noexcept;
+    void merge_delta(const GridDelta &delta) noexcept;
+
+    unsigned int get_words_per_row() const noexcept;
+    unsigned int get_stride() const noexcept;
+    std::uint64_t *get_row(const int y) noexcept;
+    const std::uint64_t *get_row(const int y) const noexcept;
+
+    Layout get_layout() const;
+    Grid to_layout(const Layout layout) const;
+
+    int get_halo() const;
+    void refresh_halo(const bool toroidal);
+    void refresh_halo(const bool toroidal, const BoundingBox &region);
+
+    CellReference operator()(const int x, const int y);
+    Cell operator()(const int x, const int y) const;
 
     Grid crop(const int x0, const int y0, const int x1, const int y1) const;
+    GridView view(const int x0, const int y0, const int x1, const int y1) const;
+
+    void merge(const GridView &other, const int x0, const int y0, const bool alive_only = false);
+    void merge(const Grid &other, const int x0, const int y0, const bool alive_only = false);
 
-    void merge(const Grid other, const int x0, const int y0, const bool alive_only = false);
+    void apply(const CellOp op, const GridView &other, const int x0 = 0, const int y0 = 0);
+    void apply(const CellOp op, const Grid &other, const int x0 = 0, const int y0 = 0);
+    Grid combine(const CellOp op, const GridView &other, const int x0 = 0, const int y0 = 0) const;
+    Grid combine(const CellOp op, const Grid &other, const int x0 = 0, const int y0 = 0) const;
+    std::uint64_t count_cells(const CellOp op, const GridView &other, const int x0 = 0, const int y0 = 0) const;
+    std::uint64_t count_cells(const CellOp op, const Grid &other, const int x0 = 0, const int y0 = 0) const;
 
     Grid rotate(const int _rotation) const;
+    void rotate_in_place(const int rotation);
+
+    Grid transpose() const;
+    Grid flip_horizontal() const;
+    Grid flip_vertical() const;
 
     friend std::ostream &operator<<(std::ostream &os, const Grid &grid);
     // How to draw an owl:
     //     Step 1. Draw a circle.
     //     Step 2. Draw the rest of the owl.
-};
\ No newline at end of file
+};
+
+/**
+ * Declare the structure of the GridView class, a read-only window onto the packed cells of a Grid
+ * that does not own or copy them. Any Grid converts implicitly to a view of all of its cells.
+ */
+class GridView
+{
+private:
+    const std::uint64_t *words;
+    unsigned int width;
+    unsigned int height;
+    unsigned int stride;
+    unsigned int offset;
+
+public:
+    GridView(const Grid &grid);
+    GridView(const std::uint64_t *words, const unsigned int width, const unsigned int height,
+             const unsigned int stride, const unsigned int offset);
+
+    int get_width() const;
+    int get_height() const;
+    std::uint64_t get_total_cells() const;
+    std::uint64_t get_alive_cells() const;
+    std::uint64_t get_dead_cells() const;
+
+    Cell get(const int x, const int y) const;
+    Cell get_unchecked(const int x, const int y) const noexcept;
+
+    unsigned int get_stride() const noexcept;
+    unsigned int get_offset() const noexcept;
+    const std::uint64_t *get_row(const int y) const noexcept;
+
+    GridView crop(const int x0, const int y0, const int x1, const int y1) const;
+};
+
+std::ostream &operator<<(std::ostream &os, const GridView &view);
\ No newline at end of file
@@ -0,0 +1,895 @@
+/**
+ * Implements a class for running the Game of Life on an unbounded plane with Gosper's HashLife algorithm.
+ *      - The plane is a quadtree. A node of level k is a square of 2^k by 2^k cells made of four nodes
+ *        of level k - 1, down to the single dead and alive cells of level 0.
+ *          - Nodes are hash consed, every distinct square is stored once and shared by every place it
+ *            appears, so repeated and empty space costs almost nothing.
+ *          - The root is centred on the origin, covering [-2^(k-1), 2^(k-1)) on both axes, and grows
+ *            by adding empty space around it when cells are set or the pattern spreads.
+ *
+ *      - Every node of level k can give its result, the centre 2^(k-1) square of cells advanced by
+ *        2^j generations for any j up to k - 2, computed from the results of its sub-squares and memoized
+ *        on the node. Patterns that repeat in space or time are only ever computed once.
+ *          - HashLife::advance(steps) moves forward by any number of generations, one jump of 2^j
+ *            generations for each set bit j of the count, so generation 2^30 is a single jump.
+ *          - The cells are outside any Grid, there are no edges and no torus.
+ *
+ *      - Nodes live in a pool and are found through a hash table, both of which grow as needed.
+ *          - Unreachable nodes are reclaimed by a mark and sweep garbage collection, which keeps the
+ *            memoized results of the nodes it keeps unless asked to drop them.
+ *          - Before each jump the memory used is checked against a cap. Over the cap a collection runs, and
+ *            if that does not get below half the cap the memoized results are dropped too.
+ *            A single jump can still go over the cap while it runs.
+ *
+ *      - HashLife objects can be made from any Grid or GridView, so Zoo loaders work unchanged,
+ *        and converted back into a Grid of the live cells or of any window for printing and saving.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "hashlife.h"
+#include "bits.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+/**
+ * no_node, no_result, free_level
+ *
+ * Markers for an empty hash chain or free list, a node without a memoized result, and a node on the free list.
+ */
+static const std::uint32_t no_node = 0xFFFFFFFF;
+static const unsigned char no_result = 0xFF;
+static const unsigned char free_level = 0xFF;
+
+/**
+ * min_root_level, max_root_level
+ *
+ * The root is always at least an 8x8 square, and at most a square whose corners still fit 64 bit coordinates.
+ */
+static const unsigned int min_root_level = 3;
+static const unsigned int max_root_level = 62;
+
+/**
+ * HashLife::HashLife()
+ *
+ * Construct an empty plane at generation 0.
+ *
+ * @example
+ *
+ *      // Make an empty plane and bring a cell to life far from the origin
+ *      HashLife life;
+ *      life.set(1000000000, -5, Cell::ALIVE);
+ */
+HashLife::HashLife()
+    : free_nodes(no_node), node_count(2), memory_cap(std::size_t(1) << 30), generation(0)
+{
+    //the two single cells are the leaves every other node is built from
+    nodes.push_back(Node{0, 0, 0, 0, no_node, no_node, 0, 0, no_result, false});
+    nodes.push_back(Node{0, 0, 0, 0, no_node, no_node, 1, 0, no_result, false});
+    buckets.assign(std::size_t(1) << 16, no_node);
+    root = get_empty(min_root_level);
+}
+
+/**
+ * HashLife::HashLife(view)
+ *
+ * Construct a plane at generation 0 holding the cells of a Grid or GridView, with cell (x, y)
+ * of the view at (x, y) on the plane. Blocks of 8x8 cells with no alive cells are skipped a row at a time.
+ *
+ * @example
+ *
+ *      // Run a methuselah out to generation 2^20
+ *      HashLife life(Zoo::r_pentomino());
+ *      life.advance_pow2(20);
+ *
+ * @param view
+ *      The cells to copy onto the plane.
+ */
+HashLife::HashLife(const GridView &view) : HashLife()
+{
+    load(view);
+}
+
+/**
+ * HashLife::HashLife(grid)
+ *
+ * Construct a plane at generation 0 holding the cells of a Grid, as HashLife::HashLife(view).
+ * A tiled grid cannot be viewed, so it is converted to a row major copy first.
+ *
+ * @param grid
+ *      The cells to copy onto the plane.
+ */
+HashLife::HashLife(const Grid &grid) : HashLife()
+{
+    if (grid.get_layout() == Layout::TILED)
+    {
+        load(GridView(grid.to_layout(Layout::ROW_MAJOR)));
+    }
+    else
+    {
+        load(GridView(grid));
+    }
+}
+
+/**
+ * HashLife::load(view)
+ *
+ * Private helper function to put the cells of a view on an empty plane, with cell (x, y) of the view
+ * at (x, y) on the plane, expanding the root until the view fits in its middle.
+ *
+ * @param view
+ *      The cells to copy onto the plane.
+ */
+void HashLife::load(const GridView &view)
+{
+    while (get_root_size() / 2 < std::max(view.get_width(), view.get_height()))
+    {
+        expand();
+    }
+    root = build(view, nodes[root].level, -get_root_size() / 2, -get_root_size() / 2);
+}
+
+/**
+ * HashLife::get_generation()
+ *
+ * Gets the number of generations the plane has been advanced by.
+ *
+ * @return
+ *      The generation.
+ */
+std::uint64_t HashLife::get_generation() const
+{
+    return generation;
+}
+
+/**
+ * HashLife::get_alive_cells()
+ *
+ * Gets the number of alive cells on the plane, kept on every node so this takes O(1) time.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+std::uint64_t HashLife::get_alive_cells() const
+{
+    return nodes[root].population;
+}
+
+/**
+ * HashLife::get_live_box()
+ *
+ * Gets the bounding box of the alive cells. Only the nodes that can still grow the box found so far
+ * are visited, so this is fast even for huge populations.
+ *
+ * @return
+ *      The smallest box holding every alive cell, or an empty box at 0,0 if no cells are alive.
+ */
+PlaneBox HashLife::get_live_box() const
+{
+    PlaneBox box = {0, 0, 0, 0};
+    find_live_box(root, -get_root_size() / 2, -get_root_size() / 2, box);
+    return box;
+}
+
+/**
+ * HashLife::get(x, y)
+ *
+ * Gets a cell of the plane.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @return
+ *      The cell, Cell::DEAD anywhere nothing has been set or grown.
+ */
+Cell HashLife::get(const std::int64_t x, const std::int64_t y) const
+{
+    const std::int64_t half = get_root_size() / 2;
+    if (x < -half || x >= half || y < -half || y >= half)
+    {
+        return Cell::DEAD;
+    }
+    std::uint32_t id = root;
+    std::int64_t node_x = x + half;
+    std::int64_t node_y = y + half;
+    while (nodes[id].level > 0 && nodes[id].population > 0)
+    {
+        const Node &node = nodes[id];
+        const std::int64_t quadrant = std::int64_t(1) << (node.level - 1);
+        const bool east = node_x >= quadrant;
+        const bool south = node_y >= quadrant;
+        id = south ? (east ? node.se : node.sw) : (east ? node.ne : node.nw);
+        node_x -= east ? quadrant : 0;
+        node_y -= south ? quadrant : 0;
+    }
+    return (nodes[id].population > 0) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * HashLife::set(x, y, value)
+ *
+ * Sets a cell of the plane, growing the root until it covers the cell.
+ * Only the nodes on the path from the root to the cell are rebuilt.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param value
+ *      The new state of the cell.
+ *
+ * @throws
+ *      std::out_of_range if the cell is outside the 2^62 square the plane can cover.
+ */
+void HashLife::set(const std::int64_t x, const std::int64_t y, const Cell value)
+{
+    while (x < -get_root_size() / 2 || x >= get_root_size() / 2 || y < -get_root_size() / 2 || y >= get_root_size() / 2)
+    {
+        expand();
+    }
+    root = set_cell(root, x + get_root_size() / 2, y + get_root_size() / 2, value);
+}
+
+/**
+ * HashLife::advance(steps)
+ *
+ * Advance the plane by any number of generations, as one jump of 2^j generations for each set bit j
+ * of the count. The memory cap is checked before each jump.
+ *
+ * @example
+ *
+ *      // Run a breeder for a billion generations
+ *      life.advance(1000000000);
+ *
+ * @param steps
+ *      The number of generations to advance.
+ *
+ * @throws
+ *      std::out_of_range if the pattern spreads past the 64 bit coordinate range.
+ */
+void HashLife::advance(const std::uint64_t steps)
+{
+    for (unsigned int exponent = 0; exponent < 64; exponent++)
+    {
+        if ((steps >> exponent) & 1)
+        {
+            advance_pow2(exponent);
+        }
+    }
+}
+
+/**
+ * HashLife::advance_pow2(exponent)
+ *
+ * Advance the plane by 2^exponent generations in a single jump, after checking the memory cap.
+ *
+ * @param exponent
+ *      The power of two of the number of generations, below 64.
+ *
+ * @throws
+ *      std::invalid_argument if the exponent is 64 or more.
+ *      std::out_of_range if the pattern spreads past the 64 bit coordinate range.
+ */
+void HashLife::advance_pow2(const unsigned int exponent)
+{
+    if (exponent >= 64)
+    {
+        throw std::invalid_argument("can only advance by up to 2^63 generations at once.");
+    }
+    if (get_memory_bytes() > memory_cap)
+    {
+        collect_garbage(true);
+        if (get_memory_bytes() > memory_cap / 2)
+        {
+            collect_garbage(false);
+        }
+    }
+    jump(exponent);
+}
+
+/**
+ * HashLife::to_grid()
+ *
+ * Make a Grid of the bounding box of the alive cells, so the plane can be printed with operator<<
+ * or saved with Zoo. The top left of the grid is the corner of HashLife::get_live_box().
+ *
+ * @example
+ *
+ *      // Print a glider a million generations later
+ *      HashLife life(Zoo::glider());
+ *      life.advance(1000000);
+ *      std::cout << life.to_grid() << std::endl;
+ *
+ * @return
+ *      A grid of the alive cells, 0x0 if none are alive.
+ *
+ * @throws
+ *      std::out_of_range if the box is too large for a Grid.
+ */
+Grid HashLife::to_grid() const
+{
+    const PlaneBox box = get_live_box();
+    return to_grid(box.x0, box.y0, box.x1, box.y1);
+}
+
+/**
+ * HashLife::to_grid(x0, y0, x1, y1)
+ *
+ * Make a Grid of the window [x0, x1) by [y0, y1) of the plane. Empty nodes are skipped whole.
+ *
+ * @example
+ *
+ *      // Get back the area a grid was loaded into
+ *      HashLife life(grid);
+ *      life.advance(100);
+ *      Grid after = life.to_grid(0, 0, grid.get_width(), grid.get_height());
+ *
+ * @param x0
+ *      Left coordinate of the window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A grid of the cells in the window.
+ *
+ * @throws
+ *      std::out_of_range if the window is inverted or too large for a Grid.
+ */
+Grid HashLife::to_grid(const std::int64_t x0, const std::int64_t y0, const std::int64_t x1, const std::int64_t y1) const
+{
+    if (x1 < x0 || y1 < y0 || x1 - x0 > INT_MAX || y1 - y0 > INT_MAX)
+    {
+        throw std::out_of_range("window must not be inverted or larger than a grid.");
+    }
+    Grid grid(x1 - x0, y1 - y0);
+    draw(root, -get_root_size() / 2, -get_root_size() / 2, PlaneBox{x0, y0, x1, y1}, grid);
+    return grid;
+}
+
+/**
+ * HashLife::get_node_count()
+ *
+ * Gets the number of nodes in use, including memoized results not yet collected.
+ *
+ * @return
+ *      The number of nodes.
+ */
+std::size_t HashLife::get_node_count() const
+{
+    return node_count;
+}
+
+/**
+ * HashLife::get_memory_bytes()
+ *
+ * Gets the memory used by the nodes in use and the hash table, the figure compared with the memory cap.
+ *
+ * @return
+ *      The memory used in bytes.
+ */
+std::size_t HashLife::get_memory_bytes() const
+{
+    return node_count * sizeof(Node) + buckets.size() * sizeof(std::uint32_t);
+}
+
+/**
+ * HashLife::get_memory_cap()
+ *
+ * Gets the memory the nodes may use before a garbage collection runs.
+ *
+ * @return
+ *      The memory cap in bytes, 1 GiB by default.
+ */
+std::size_t HashLife::get_memory_cap() const
+{
+    return memory_cap;
+}
+
+/**
+ * HashLife::set_memory_cap(bytes)
+ *
+ * Sets the memory the nodes may use before a garbage collection runs, collecting straight away
+ * if the plane is already over it. The cap is checked before each jump, a single jump can go over it.
+ *
+ * @example
+ *
+ *      // Keep a long run under 256 MiB
+ *      life.set_memory_cap(std::size_t(256) << 20);
+ *
+ * @param bytes
+ *      The memory cap in bytes.
+ */
+void HashLife::set_memory_cap(const std::size_t bytes)
+{
+    memory_cap = bytes;
+    if (get_memory_bytes() > memory_cap)
+    {
+        collect_garbage(true);
+    }
+}
+
+/**
+ * HashLife::collect_garbage(keep_results)
+ *
+ * Free every node that is not part of the plane, marking from the root, the empty nodes, and
+ * optionally the memoized results of the nodes kept. Freed nodes are reused by later nodes.
+ *
+ * @param keep_results
+ *      Optional parameter. If true the memoized results of kept nodes, and the nodes they are built from,
+ *      are kept so future jumps can reuse them. If false every memoized result is dropped. Defaults to true.
+ */
+void HashLife::collect_garbage(const bool keep_results)
+{
+    for (Node &node : nodes)
+    {
+        node.marked = false;
+        if (!keep_results)
+        {
+            node.result_exponent = no_result;
+        }
+    }
+
+    std::vector<std::uint32_t> stack(empty_nodes);
+    stack.push_back(root);
+    stack.push_back(0);
+    stack.push_back(1);
+    while (!stack.empty())
+    {
+        Node &node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.marked)
+        {
+            continue;
+        }
+        node.marked = true;
+        if (node.level > 0)
+        {
+            stack.insert(stack.end(), {node.nw, node.ne, node.sw, node.se});
+        }
+        if (node.result_exponent != no_result)
+        {
+            stack.push_back(node.result);
+        }
+    }
+
+    //rebuild the free list from the top down so the lowest free nodes are reused first
+    free_nodes = no_node;
+    node_count = 0;
+    for (std::size_t id = nodes.size(); id-- > 0;)
+    {
+        Node &node = nodes[id];
+        if (node.marked)
+        {
+            node_count++;
+            continue;
+        }
+        node.level = free_level;
+        node.result_exponent = no_result;
+        node.next = free_nodes;
+        free_nodes = id;
+    }
+    rehash(buckets.size());
+}
+
+/**
+ * HashLife::get_hash(nw, ne, sw, se)
+ *
+ * Private helper function to hash the four quadrants of a node.
+ */
+std::uint64_t HashLife::get_hash(const std::uint32_t nw, const std::uint32_t ne, const std::uint32_t sw,
+                                 const std::uint32_t se)
+{
+    return mix_bits(((std::uint64_t(nw) << 32) | ne) ^ mix_bits((std::uint64_t(sw) << 32) | se));
+}
+
+/**
+ * HashLife::join(nw, ne, sw, se)
+ *
+ * Private helper function to get the canonical node made of four quadrants of the same level,
+ * creating it if it does not exist yet. References into the node pool are invalidated by a new node.
+ *
+ * @return
+ *      The id of the node.
+ *
+ * @throws
+ *      std::runtime_error if the node pool is full.
+ */
+std::uint32_t HashLife::join(const std::uint32_t nw, const std::uint32_t ne, const std::uint32_t sw,
+                             const std::uint32_t se)
+{
+    const std::size_t bucket = get_hash(nw, ne, sw, se) & (buckets.size() - 1);
+    for (std::uint32_t id = buckets[bucket]; id != no_node; id = nodes[id].next)
+    {
+        const Node &node = nodes[id];
+        if (node.nw == nw && node.ne == ne && node.sw == sw && node.se == se)
+        {
+            return id;
+        }
+    }
+
+    const unsigned char level = nodes[nw].level + 1;
+    const std::uint64_t population = nodes[nw].population + nodes[ne].population
+                                     + nodes[sw].population + nodes[se].population;
+    std::uint32_t id = free_nodes;
+    if (id != no_node)
+    {
+        free_nodes = nodes[id].next;
+    }
+    else if (nodes.size() < no_node)
+    {
+        id = nodes.size();
+        nodes.push_back(Node());
+    }
+    else
+    {
+        throw std::runtime_error("hashlife node pool is full.");
+    }
+    nodes[id] = Node{nw, ne, sw, se, no_node, buckets[bucket], population, level, no_result, false};
+    buckets[bucket] = id;
+    node_count++;
+
+    //keep about one node per bucket
+    if (node_count > buckets.size())
+    {
+        rehash(buckets.size() * 2);
+    }
+    return id;
+}
+
+/**
+ * HashLife::rehash(bucket_count)
+ *
+ * Private helper function to rebuild the hash table with a power of two number of buckets.
+ */
+void HashLife::rehash(const std::size_t bucket_count)
+{
+    buckets.assign(bucket_count, no_node);
+    for (std::size_t id = 2; id < nodes.size(); id++)
+    {
+        Node &node = nodes[id];
+        if (node.level == free_level)
+        {
+            continue;
+        }
+        const std::size_t bucket = get_hash(node.nw, node.ne, node.sw, node.se) & (bucket_count - 1);
+        node.next = buckets[bucket];
+        buckets[bucket] = id;
+    }
+}
+
+/**
+ * HashLife::get_empty(level)
+ *
+ * Private helper function to get the node of a level with no alive cells, built the first time it is needed.
+ */
+std::uint32_t HashLife::get_empty(const unsigned int level)
+{
+    while (empty_nodes.size() <= level)
+    {
+        const std::uint32_t below = empty_nodes.empty() ? 0 : empty_nodes.back();
+        empty_nodes.push_back(empty_nodes.empty() ? 0 : join(below, below, below, below));
+    }
+    return empty_nodes[level];
+}
+
+/**
+ * HashLife::get_centre(id)
+ *
+ * Private helper function to get the centre square of a node of level 2 or more, one level down.
+ */
+std::uint32_t HashLife::get_centre(const std::uint32_t id)
+{
+    const Node node = nodes[id];
+    return join(nodes[node.nw].se, nodes[node.ne].sw, nodes[node.sw].ne, nodes[node.se].nw);
+}
+
+/**
+ * HashLife::step_block(id)
+ *
+ * Private helper function to advance the centre 2x2 cells of a 4x4 node by one generation,
+ * applying the rules of Conway's Game of Life to the 16 cells directly.
+ *
+ * @return
+ *      The level 1 node of the next state of the centre cells.
+ */
+std::uint32_t HashLife::step_block(const std::uint32_t id)
+{
+    //bit 4r + c holds the cell at row r and column c
+    const Node node = nodes[id];
+    const std::uint32_t quadrants[4] = {node.nw, node.ne, node.sw, node.se};
+    unsigned int cells = 0;
+    for (unsigned int q = 0; q < 4; q++)
+    {
+        const Node &quadrant = nodes[quadrants[q]];
+        const std::uint32_t quadrant_cells[4] = {quadrant.nw, quadrant.ne, quadrant.sw, quadrant.se};
+        for (unsigned int c = 0; c < 4; c++)
+        {
+            cells |= quadrant_cells[c] << (4 * (2 * (q >> 1) + (c >> 1)) + 2 * (q & 1) + (c & 1));
+        }
+    }
+
+    std::uint32_t next[4];
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        const unsigned int row = 1 + (i >> 1);
+        const unsigned int column = 1 + (i & 1);
+        unsigned int neighbours = 0;
+        for (unsigned int r = row - 1; r <= row + 1; r++)
+        {
+            for (unsigned int c = column - 1; c <= column + 1; c++)
+            {
+                neighbours += (cells >> (4 * r + c)) & 1;
+            }
+        }
+        const unsigned int alive = (cells >> (4 * row + column)) & 1;
+        neighbours -= alive;
+        next[i] = (neighbours == 3 || (neighbours == 2 && alive)) ? 1 : 0;
+    }
+    return join(next[0], next[1], next[2], next[3]);
+}
+
+/**
+ * HashLife::get_result(id, exponent)
+ *
+ * Private helper function to get the centre square of a node of level k, advanced by 2^exponent generations
+ * for an exponent up to k - 2. Results are memoized on the node for the last exponent asked for.
+ *
+ * The node is split into 9 overlapping squares of level k - 1. At full speed (exponent k - 2) each of
+ * them is advanced by 2^(k-3) generations, joined into 4 squares, and advanced by 2^(k-3) again.
+ * Otherwise the 9 squares are only cropped to their centres, and the 4 joined squares are advanced
+ * by the whole 2^exponent generations.
+ *
+ * @return
+ *      The node of level k - 1 holding the result.
+ */
+std::uint32_t HashLife::get_result(const std::uint32_t id, const unsigned int exponent)
+{
+    const Node node = nodes[id];
+    if (node.population == 0)
+    {
+        return get_empty(node.level - 1);
+    }
+    else if (node.result_exponent == exponent)
+    {
+        return node.result;
+    }
+
+    std::uint32_t result;
+    if (node.level == 2)
+    {
+        result = step_block(id);
+    }
+    else
+    {
+        const Node nw = nodes[node.nw];
+        const Node ne = nodes[node.ne];
+        const Node sw = nodes[node.sw];
+        const Node se = nodes[node.se];
+        //the 9 squares of half the size, row by row, overlapping by a quarter
+        const std::uint32_t squares[9] = {
+            node.nw, join(nw.ne, ne.nw, nw.se, ne.sw), node.ne,
+            join(nw.sw, nw.se, sw.nw, sw.ne), join(nw.se, ne.sw, sw.ne, se.nw), join(ne.sw, ne.se, se.nw, se.ne),
+            node.sw, join(sw.ne, se.nw, sw.se, se.sw), node.se};
+
+        const bool full_speed = (exponent == node.level - 2u);
+        std::uint32_t parts[9];
+        for (unsigned int i = 0; i < 9; i++)
+        {
+            parts[i] = full_speed ? get_result(squares[i], exponent - 1) : get_centre(squares[i]);
+        }
+        const unsigned int remaining = full_speed ? exponent - 1 : exponent;
+        const std::uint32_t quarters[4] = {
+            get_result(join(parts[0], parts[1], parts[3], parts[4]), remaining),
+            get_result(join(parts[1], parts[2], parts[4], parts[5]), remaining),
+            get_result(join(parts[3], parts[4], parts[6], parts[7]), remaining),
+            get_result(join(parts[4], parts[5], parts[7], parts[8]), remaining)};
+        result = join(quarters[0], quarters[1], quarters[2], quarters[3]);
+    }
+    nodes[id].result = result;
+    nodes[id].result_exponent = exponent;
+    return result;
+}
+
+/**
+ * HashLife::get_root_size()
+ *
+ * Private helper function to get the edge size of the root, which covers [-size / 2, size / 2) on both axes.
+ */
+std::int64_t HashLife::get_root_size() const
+{
+    return std::int64_t(1) << nodes[root].level;
+}
+
+/**
+ * HashLife::is_padded(id)
+ *
+ * Private helper function to check whether every alive cell of a node of level 2 or more
+ * is inside its centre square.
+ */
+bool HashLife::is_padded(const std::uint32_t id) const
+{
+    const Node &node = nodes[id];
+    const std::uint64_t centre = nodes[nodes[node.nw].se].population + nodes[nodes[node.ne].sw].population
+                                 + nodes[nodes[node.sw].ne].population + nodes[nodes[node.se].nw].population;
+    return centre == node.population;
+}
+
+/**
+ * HashLife::expand()
+ *
+ * Private helper function to double the edge of the root, surrounding it with empty space
+ * so it stays centred on the origin.
+ *
+ * @throws
+ *      std::out_of_range if the root would no longer fit 64 bit coordinates.
+ */
+void HashLife::expand()
+{
+    const Node node = nodes[root];
+    if (node.level >= max_root_level)
+    {
+        throw std::out_of_range("pattern grew past the 64 bit coordinate range.");
+    }
+    const std::uint32_t empty = get_empty(node.level - 1);
+    const std::uint32_t nw = join(empty, empty, empty, node.nw);
+    const std::uint32_t ne = join(empty, empty, node.ne, empty);
+    const std::uint32_t sw = join(empty, node.sw, empty, empty);
+    const std::uint32_t se = join(node.se, empty, empty, empty);
+    root = join(nw, ne, sw, se);
+}
+
+/**
+ * HashLife::jump(exponent)
+ *
+ * Private helper function to advance the root by 2^exponent generations.
+ * The root is grown until it is large enough for the jump and every alive cell is in its centre,
+ * then once more, so no cell can travel out of the result in 2^exponent generations.
+ */
+void HashLife::jump(const unsigned int exponent)
+{
+    while (nodes[root].level < exponent + 2 || !is_padded(root))
+    {
+        expand();
+    }
+    expand();
+    root = get_result(root, exponent);
+    generation += std::uint64_t(1) << exponent;
+}
+
+/**
+ * HashLife::build(view, level, x0, y0)
+ *
+ * Private helper function to build the node of a level with its top left cell at (x0, y0) from the cells
+ * of a view at (0, 0). Blocks of 8x8 cells are read a row at a time and skipped if they are all dead.
+ */
+std::uint32_t HashLife::build(const GridView &view, const unsigned int level, const std::int64_t x0,
+                              const std::int64_t y0)
+{
+    const std::int64_t size = std::int64_t(1) << level;
+    const std::int64_t width = view.get_width();
+    const std::int64_t height = view.get_height();
+    if (x0 >= width || y0 >= height || x0 + size <= 0 || y0 + size <= 0)
+    {
+        return get_empty(level);
+    }
+    else if (level == 0)
+    {
+        return view.get_unchecked(x0, y0) == Cell::ALIVE;
+    }
+    else if (level == 3)
+    {
+        //the part of the block inside the view is at most 8 cells of each row
+        const std::int64_t start = std::max<std::int64_t>(x0, 0);
+        const std::int64_t end = std::min(x0 + size, width);
+        std::uint64_t bits = 0;
+        for (std::int64_t y = std::max<std::int64_t>(y0, 0); y < std::min(y0 + size, height); y++)
+        {
+            bits |= read_bits(view.get_row(y), view.get_offset() + start, end - start);
+        }
+        if (bits == 0)
+        {
+            return get_empty(level);
+        }
+    }
+
+    const std::int64_t half = size / 2;
+    const std::uint32_t nw = build(view, level - 1, x0, y0);
+    const std::uint32_t ne = build(view, level - 1, x0 + half, y0);
+    const std::uint32_t sw = build(view, level - 1, x0, y0 + half);
+    const std::uint32_t se = build(view, level - 1, x0 + half, y0 + half);
+    return join(nw, ne, sw, se);
+}
+
+/**
+ * HashLife::set_cell(id, x, y, value)
+ *
+ * Private helper function to rebuild a node with the cell at (x, y) relative to its top left set to a value.
+ */
+std::uint32_t HashLife::set_cell(const std::uint32_t id, const std::int64_t x, const std::int64_t y, const Cell value)
+{
+    const Node node = nodes[id];
+    if (node.level == 0)
+    {
+        return value == Cell::ALIVE;
+    }
+    const std::int64_t half = std::int64_t(1) << (node.level - 1);
+    if (y < half)
+    {
+        return (x < half) ? join(set_cell(node.nw, x, y, value), node.ne, node.sw, node.se)
+                          : join(node.nw, set_cell(node.ne, x - half, y, value), node.sw, node.se);
+    }
+    return (x < half) ? join(node.nw, node.ne, set_cell(node.sw, x, y - half, value), node.se)
+                      : join(node.nw, node.ne, node.sw, set_cell(node.se, x - half, y - half, value));
+}
+
+/**
+ * HashLife::find_live_box(id, x0, y0, box)
+ *
+ * Private helper function to grow a box to cover the alive cells of a node with its top left at (x0, y0).
+ * Nodes already inside the box cannot grow it and are skipped.
+ */
+void HashLife::find_live_box(const std::uint32_t id, const std::int64_t x0, const std::int64_t y0, PlaneBox &box) const
+{
+    const Node &node = nodes[id];
+    const std::int64_t size = std::int64_t(1) << node.level;
+    const bool found = box.x0 < box.x1;
+    if (node.population == 0
+        || (found && x0 >= box.x0 && y0 >= box.y0 && x0 + size <= box.x1 && y0 + size <= box.y1))
+    {
+        return;
+    }
+    else if (node.level == 0)
+    {
+        box = found ? PlaneBox{std::min(box.x0, x0), std::min(box.y0, y0), std::max(box.x1, x0 + 1), std::max(box.y1, y0 + 1)}
+                    : PlaneBox{x0, y0, x0 + 1, y0 + 1};
+        return;
+    }
+    const std::int64_t half = size / 2;
+    find_live_box(node.nw, x0, y0, box);
+    find_live_box(node.ne, x0 + half, y0, box);
+    find_live_box(node.sw, x0, y0 + half, box);
+    find_live_box(node.se, x0 + half, y0 + half, box);
+}
+
+/**
+ * HashLife::draw(id, x0, y0, window, grid)
+ *
+ * Private helper function to set the alive cells of a node with its top left at (x0, y0) that fall
+ * inside a window of the plane into a grid of the window.
+ */
+void HashLife::draw(const std::uint32_t id, const std::int64_t x0, const std::int64_t y0, const PlaneBox &window,
+                    Grid &grid) const
+{
+    const Node &node = nodes[id];
+    const std::int64_t size = std::int64_t(1) << node.level;
+    if (node.population == 0 || x0 >= window.x1 || y0 >= window.y1 || x0 + size <= window.x0 || y0 + size <= window.y0)
+    {
+        return;
+    }
+    else if (node.level == 0)
+    {
+        grid.set_unchecked(x0 - window.x0, y0 - window.y0, Cell::ALIVE);
+        return;
+    }
+    const std::int64_t half = size / 2;
+    draw(node.nw, x0, y0, window, grid);
+    draw(node.ne, x0 + half, y0, window, grid);
+    draw(node.sw, x0, y0 + half, window, grid);
+    draw(node.se, x0 + half, y0 + half, window, grid);
+}
@@ -0,0 +1,106 @@
+/**
+ * Declares a class for running the Game of Life on an unbounded plane with Gosper's HashLife algorithm.
+ * Rich documentation for the api and behaviour the HashLife class can be found in hashlife.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "grid.h"
+
+/**
+ * A PlaneBox is a bounding box on the unbounded plane, covering [x0, x1) by [y0, y1) with 64 bit coordinates.
+ */
+struct PlaneBox
+{
+    std::int64_t x0;
+    std::int64_t y0;
+    std::int64_t x1;
+    std::int64_t y1;
+};
+
+/**
+ * Declare the structure of the HashLife class, which stores the plane as a quadtree of shared,
+ * canonical nodes and memoizes the future of every node so repeated patterns are only computed once.
+ */
+class HashLife
+{
+private:
+    /**
+     * A square of 2^level cells, split into four quadrants of 2^(level - 1) cells.
+     * Nodes 0 and 1 are the dead and alive single cells of level 0.
+     */
+    struct Node
+    {
+        std::uint32_t nw;
+        std::uint32_t ne;
+        std::uint32_t sw;
+        std::uint32_t se;
+        std::uint32_t result;
+        std::uint32_t next;
+        std::uint64_t population;
+        unsigned char level;
+        unsigned char result_exponent;
+        bool marked;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> buckets;
+    std::vector<std::uint32_t> empty_nodes;
+    std::uint32_t free_nodes;
+    std::size_t node_count;
+    std::size_t memory_cap;
+    std::uint32_t root;
+    std::uint64_t generation;
+
+    static std::uint64_t get_hash(const std::uint32_t nw, const std::uint32_t ne, const std::uint32_t sw,
+                                  const std::uint32_t se);
+    std::uint32_t join(const std::uint32_t nw, const std::uint32_t ne, const std::uint32_t sw, const std::uint32_t se);
+    void rehash(const std::size_t bucket_count);
+    std::uint32_t get_empty(const unsigned int level);
+    std::uint32_t get_centre(const std::uint32_t id);
+    std::uint32_t step_block(const std::uint32_t id);
+    std::uint32_t get_result(const std::uint32_t id, const unsigned int exponent);
+
+    std::int64_t get_root_size() const;
+    bool is_padded(const std::uint32_t id) const;
+    void expand();
+    void jump(const unsigned int exponent);
+    void load(const GridView &view);
+
+    std::uint32_t build(const GridView &view, const unsigned int level, const std::int64_t x0, const std::int64_t y0);
+    std::uint32_t set_cell(const std::uint32_t id, const std::int64_t x, const std::int64_t y, const Cell value);
+    void find_live_box(const std::uint32_t id, const std::int64_t x0, const std::int64_t y0, PlaneBox &box) const;
+    void draw(const std::uint32_t id, const std::int64_t x0, const std::int64_t y0, const PlaneBox &window,
+              Grid &grid) const;
+
+public:
+    HashLife();
+    explicit HashLife(const GridView &view);
+    explicit HashLife(const Grid &grid);
+
+    std::uint64_t get_generation() const;
+    std::uint64_t get_alive_cells() const;
+    PlaneBox get_live_box() const;
+
+    Cell get(const std::int64_t x, const std::int64_t y) const;
+    void set(const std::int64_t x, const std::int64_t y, const Cell value);
+
+    void advance(const std::uint64_t steps);
+    void advance_pow2(const unsigned int exponent);
+
+    Grid to_grid() const;
+    Grid to_grid(const std::int64_t x0, const std::int64_t y0, const std::int64_t x1, const std::int64_t y1) const;
+
+    std::size_t get_node_count() const;
+    std::size_t get_memory_bytes() const;
+    std::size_t get_memory_cap() const;
+    void set_memory_cap(const std::size_t bytes);
+    void collect_garbage(const bool keep_results = true);
+};
@@ -0,0 +1,712 @@
+/**
+ * Implements classes for running Larger than Life and Generations rules.
+ *      - A RangeRule counts the alive cells in the (2R + 1) square around each cell, for a range R of 1 up to 500.
+ *          - Larger than Life rules are written as in Golly, "R5,C0,M1,S34..58,B34..45,NM".
+ *            R is the range, C the number of states, M 1 if the cell counts itself, and S and B the range
+ *            of counts for survival and birth. N is the neighbourhood, only the Moore square NM is supported.
+ *          - Generations rules are written "B2/S/C3" or "/2/3", a Life-like rule with a number of states.
+ *          - Life-like rules such as "B3/S23" are Generations rules with 2 states.
+ *          - https://conwaylife.com/wiki/Larger_than_Life
+ *          - https://conwaylife.com/wiki/Generations
+ *
+ *      - A RangeWorld holds one CellState per cell, so a cell can be alive, dead, or one of the dying states.
+ *          - Only alive cells are counted as neighbours. An alive cell that does not survive starts dying,
+ *            and a dying cell counts up a state each generation until it is dead again.
+ *
+ *      - Counting the neighbours of every cell one at a time costs (2R + 1)^2 reads per cell.
+ *        Instead each step builds a summed-area table of the alive cells, where each entry is the number
+ *        of alive cells above and to the left of it, so any square is summed from its 4 corners.
+ *          - The table covers the world padded by R cells on every side, with dead cells for a bounded
+ *            world or wrapped cells for a torus, so no square ever needs clipping.
+ *          - Building the table and counting both cost the same per cell for any range.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "range_world.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+/**
+ * RangeRule::RangeRule()
+ *
+ * Construct the rule of Conway's Game of Life, range 1 with 2 states and B3/S23.
+ */
+RangeRule::RangeRule() : RangeRule(Rule())
+{
+    //pass to Life-like rule constructor
+}
+
+/**
+ * RangeRule::RangeRule(rule, states)
+ *
+ * Construct a range 1 Generations rule from a Life-like rule and a number of states.
+ *
+ * @example
+ *
+ *      // Make Brian's Brain, B2/S/C3
+ *      RangeRule brain(Rule("B2/S"), 3);
+ *
+ * @param rule
+ *      The Life-like rule giving the birth and survival counts.
+ *
+ * @param states
+ *      Optional parameter. The number of states, 2 up to 256. Defaults to 2, a Life-like rule.
+ *
+ * @throws
+ *      std::invalid_argument if the number of states is out of range.
+ */
+RangeRule::RangeRule(const Rule &rule, const unsigned int states)
+    : range(1), states(states), middle(false), birth(9, 0), survival(9, 0)
+{
+    if (states < 2 || states > 256)
+    {
+        throw std::invalid_argument("rule must have 2 to 256 states.");
+    }
+    for (unsigned int count = 0; count <= 8; count++)
+    {
+        birth[count] = rule.get_next(false, count);
+        survival[count] = rule.get_next(true, count);
+    }
+}
+
+/**
+ * RangeRule::RangeRule(rule)
+ *
+ * Construct a rule from a Larger than Life rule string "R<range>,C<states>,M<0|1>,S<min>..<max>,B<min>..<max>,NM",
+ * a Generations rule string "B<digits>/S<digits>/C<states>" or "<survival>/<birth>/<states>",
+ * or a Life-like rule string. In a Larger than Life rule C, M, and N may be left out for C0, M0, and NM,
+ * C0 and C1 mean 2 states, and S or B may be a single count or left empty.
+ *
+ * @example
+ *
+ *      // Make Bosco's Rule
+ *      RangeRule bosco("R5,C0,M1,S34..58,B34..45,NM");
+ *
+ *      // Make Star Wars
+ *      RangeRule star_wars("345/2/4");
+ *
+ * @param rule
+ *      The rule string.
+ *
+ * @throws
+ *      std::invalid_argument if the string is not a valid rule.
+ */
+RangeRule::RangeRule(const std::string &rule) : range(1), states(2), middle(false)
+{
+    //Generations and Life-like rules split their parts with /
+    if (rule.find('/') != std::string::npos)
+    {
+        std::string parts[3];
+        unsigned int count = 0;
+        for (std::size_t start = 0, end = 0; end != std::string::npos; start = end + 1)
+        {
+            end = rule.find('/', start);
+            if (count == 3)
+            {
+                throw std::invalid_argument("rule " + rule + " must have at most three parts split by /.");
+            }
+            parts[count++] = rule.substr(start, end - start);
+        }
+        std::string life_like = parts[0] + "/" + parts[1];
+        std::string state_digits = parts[2];
+        if (count == 3)
+        {
+            //a lettered rule may put its C part anywhere
+            for (unsigned int p = 0; p < 3; p++)
+            {
+                const char letter = parts[p].empty() ? 0 : std::toupper((unsigned char)parts[p][0]);
+                if (letter == 'C' || letter == 'G')
+                {
+                    state_digits = parts[p].substr(1);
+                    life_like = parts[(p + 1) % 3] + "/" + parts[(p + 2) % 3];
+                }
+            }
+            if (state_digits.empty() || state_digits.size() > 3
+                || !std::all_of(state_digits.begin(), state_digits.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+            {
+                throw std::invalid_argument("rule " + rule + " must give its number of states.");
+            }
+        }
+        *this = RangeRule(Rule(life_like), (count == 3) ? std::stoi(state_digits) : 2);
+        return;
+    }
+
+    //Larger than Life rules list their parts split by commas, each a letter and a value
+    std::string survival_ranges;
+    std::string birth_ranges;
+    bool seen_range = false;
+    bool seen_survival = false;
+    bool seen_birth = false;
+    for (std::size_t start = 0, end = 0; end != std::string::npos; start = end + 1)
+    {
+        end = rule.find(',', start);
+        const std::string part = rule.substr(start, end - start);
+        const char letter = part.empty() ? 0 : std::toupper((unsigned char)part[0]);
+        const std::string value = part.empty() ? "" : part.substr(1);
+        const bool number = !value.empty() && value.size() <= 3
+                            && std::all_of(value.begin(), value.end(), [](const char c) { return c >= '0' && c <= '9'; });
+        if (letter == 'R' && number && !seen_range)
+        {
+            range = std::stoi(value);
+            seen_range = true;
+        }
+        else if (letter == 'C' && number)
+        {
+            states = std::max(2, std::stoi(value));
+        }
+        else if (letter == 'M' && (value == "0" || value == "1"))
+        {
+            middle = (value == "1");
+        }
+        else if (letter == 'S' && !seen_survival)
+        {
+            survival_ranges = value;
+            seen_survival = true;
+        }
+        else if (letter == 'B' && !seen_birth)
+        {
+            birth_ranges = value;
+            seen_birth = true;
+        }
+        else if (letter == 'N' && (value == "M" || value == "m"))
+        {
+            //the Moore square is the only neighbourhood
+        }
+        else
+        {
+            throw std::invalid_argument("rule " + rule + " has an invalid part " + part + ".");
+        }
+    }
+    if (!seen_range || !seen_survival || !seen_birth)
+    {
+        throw std::invalid_argument("rule " + rule + " must have R, S, and B parts.");
+    }
+    if (range < 1 || range > MAX_RANGE || states > 256)
+    {
+        throw std::invalid_argument("rule " + rule + " must have a range of 1 to 500 and at most 256 states.");
+    }
+    birth.assign(get_max_count() + 1, 0);
+    survival.assign(get_max_count() + 1, 0);
+    set_counts(survival, survival_ranges, rule);
+    set_counts(birth, birth_ranges, rule);
+}
+
+/**
+ * RangeRule::set_counts(counts, ranges, rule)
+ *
+ * Private helper function to mark the counts of a Larger than Life S or B part in a lookup table.
+ *
+ * @param counts
+ *      The table to mark, one entry for each count.
+ *
+ * @param ranges
+ *      The value of the part, "<min>..<max>", a single count, or empty for none.
+ *
+ * @param rule
+ *      The whole rule string, for the error message.
+ *
+ * @throws
+ *      std::invalid_argument if the value is not a range of counts within the neighbourhood.
+ */
+void RangeRule::set_counts(std::vector<unsigned char> &counts, const std::string &ranges, const std::string &rule)
+{
+    if (ranges.empty())
+    {
+        return;
+    }
+    const std::size_t dots = ranges.find("..");
+    const std::string bounds[2] = {ranges.substr(0, dots), (dots == std::string::npos) ? ranges : ranges.substr(dots + 2)};
+    unsigned long values[2];
+    for (unsigned int b = 0; b < 2; b++)
+    {
+        if (bounds[b].empty() || bounds[b].size() > 7
+            || !std::all_of(bounds[b].begin(), bounds[b].end(), [](const char c) { return c >= '0' && c <= '9'; }))
+        {
+            throw std::invalid_argument("rule " + rule + " has an invalid range of counts " + ranges + ".");
+        }
+        values[b] = std::stoul(bounds[b]);
+    }
+    if (values[0] > values[1] || values[1] >= counts.size())
+    {
+        throw std::invalid_argument("rule " + rule + " has counts " + ranges + " outside its neighbourhood.");
+    }
+    std::fill(counts.begin() + values[0], counts.begin() + values[1] + 1, 1);
+}
+
+/**
+ * RangeRule::get_range()
+ *
+ * Gets the range of the neighbourhood, the square of cells at most this far away in x and y.
+ *
+ * @return
+ *      The range, 1 for Generations and Life-like rules.
+ */
+unsigned int RangeRule::get_range() const
+{
+    return range;
+}
+
+/**
+ * RangeRule::get_states()
+ *
+ * Gets the number of states a cell can take, dead, alive, and the dying states between.
+ *
+ * @return
+ *      The number of states, 2 for rules without dying states.
+ */
+unsigned int RangeRule::get_states() const
+{
+    return states;
+}
+
+/**
+ * RangeRule::get_middle()
+ *
+ * Gets whether a cell counts itself as one of its neighbours when it is alive.
+ *
+ * @return
+ *      True if the cell is in its own neighbourhood.
+ */
+bool RangeRule::get_middle() const
+{
+    return middle;
+}
+
+/**
+ * RangeRule::get_max_count()
+ *
+ * Gets the largest count of alive neighbours a cell can have.
+ *
+ * @return
+ *      The number of cells in the neighbourhood.
+ */
+unsigned int RangeRule::get_max_count() const
+{
+    return (2 * range + 1) * (2 * range + 1) - (middle ? 0 : 1);
+}
+
+/**
+ * RangeRule::is_birth(count)
+ *
+ * Checks whether a dead cell with count alive neighbours is born.
+ *
+ * @return
+ *      True if the cell is born.
+ */
+bool RangeRule::is_birth(const unsigned int count) const
+{
+    return count < birth.size() && birth[count];
+}
+
+/**
+ * RangeRule::is_survival(count)
+ *
+ * Checks whether an alive cell with count alive neighbours stays alive.
+ *
+ * @return
+ *      True if the cell survives.
+ */
+bool RangeRule::is_survival(const unsigned int count) const
+{
+    return count < survival.size() && survival[count];
+}
+
+/**
+ * RangeRule::get_next(state, count)
+ *
+ * Gets the next state of a cell.
+ *      - A dead cell is born if its count is a birth count.
+ *      - An alive cell stays alive if its count is a survival count, and otherwise starts dying,
+ *        or dies straight away with only 2 states.
+ *      - A dying cell moves to the next state whatever its count, and is dead after the last one.
+ *
+ * @param state
+ *      The state of the cell now.
+ *
+ * @param count
+ *      The number of alive cells in its neighbourhood.
+ *
+ * @return
+ *      The state of the cell next generation.
+ */
+CellState RangeRule::get_next(const CellState state, const unsigned int count) const
+{
+    if (state == 0)
+    {
+        return birth[count];
+    }
+    else if (state == 1 && survival[count])
+    {
+        return 1;
+    }
+    return (state + 1u < states) ? CellState(state + 1) : 0;
+}
+
+/**
+ * RangeWorld::RangeWorld()
+ *
+ * Construct an empty world of size 0x0 running Conway's Game of Life.
+ */
+RangeWorld::RangeWorld() : RangeWorld(0, 0)
+{
+    //pass to width height constructor
+}
+
+/**
+ * RangeWorld::RangeWorld(width, height)
+ *
+ * Construct a world with the desired size filled with dead cells, running Conway's Game of Life
+ * until another rule is set.
+ *
+ * @example
+ *
+ *      // Make a 256x256 world running Bosco's Rule
+ *      RangeWorld world(256, 256);
+ *      world.set_rule(RangeRule("R5,C0,M1,S34..58,B34..45,NM"));
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ */
+RangeWorld::RangeWorld(const unsigned int width, const unsigned int height)
+    : width(width), height(height), current_states(std::size_t(width) * height, 0),
+      next_states(std::size_t(width) * height, 0), alive_cells(0)
+{
+}
+
+/**
+ * RangeWorld::RangeWorld(initial_state)
+ *
+ * Construct a world with the size of a grid, its alive cells alive and the rest dead.
+ *
+ * @param initial_state
+ *      The state of the constructed world.
+ */
+RangeWorld::RangeWorld(const Grid &initial_state)
+    : RangeWorld(initial_state.get_width(), initial_state.get_height())
+{
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            if (initial_state.get_unchecked(x, y) == Cell::ALIVE)
+            {
+                current_states[std::size_t(y) * width + x] = 1;
+                alive_cells++;
+            }
+        }
+    }
+}
+
+/**
+ * RangeWorld::get_width()
+ *
+ * Gets the current width of the world.
+ *
+ * @return
+ *      The width of the world.
+ */
+int RangeWorld::get_width() const
+{
+    return width;
+}
+
+/**
+ * RangeWorld::get_height()
+ *
+ * Gets the current height of the world.
+ *
+ * @return
+ *      The height of the world.
+ */
+int RangeWorld::get_height() const
+{
+    return height;
+}
+
+/**
+ * RangeWorld::get_total_cells()
+ *
+ * Gets the total number of cells in the world.
+ *
+ * @return
+ *      The number of total cells.
+ */
+std::uint64_t RangeWorld::get_total_cells() const
+{
+    return std::uint64_t(width) * height;
+}
+
+/**
+ * RangeWorld::get_alive_cells()
+ *
+ * Gets the number of cells in state 1, kept up to date by each step and set.
+ * Dying cells are not counted.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+std::uint64_t RangeWorld::get_alive_cells() const
+{
+    return alive_cells;
+}
+
+/**
+ * RangeWorld::get(x, y)
+ *
+ * Gets the state of a cell.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @return
+ *      The state of the cell.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate within the world.
+ */
+CellState RangeWorld::get(const int x, const int y) const
+{
+    if (x < 0 || x >= get_width() || y < 0 || y >= get_height())
+    {
+        throw std::out_of_range("get is out of bounds.");
+    }
+    return current_states[std::size_t(y) * width + x];
+}
+
+/**
+ * RangeWorld::set(x, y, state)
+ *
+ * Sets the state of a cell.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param state
+ *      The new state, less than the number of states of the rule.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate within the world.
+ *      std::invalid_argument if the state is not a state of the rule.
+ */
+void RangeWorld::set(const int x, const int y, const CellState state)
+{
+    if (x < 0 || x >= get_width() || y < 0 || y >= get_height())
+    {
+        throw std::out_of_range("set is out of bounds.");
+    }
+    if (state >= rule.get_states())
+    {
+        throw std::invalid_argument("state is not a state of the rule.");
+    }
+    CellState &cell = current_states[std::size_t(y) * width + x];
+    alive_cells += (state == 1) - (cell == 1);
+    cell = state;
+}
+
+/**
+ * RangeWorld::get_rule()
+ *
+ * Gets the rule RangeWorld::step applies.
+ *
+ * @return
+ *      A reference to the rule.
+ */
+const RangeRule &RangeWorld::get_rule() const
+{
+    return rule;
+}
+
+/**
+ * RangeWorld::set_rule(rule)
+ *
+ * Sets the rule RangeWorld::step applies. Cells in a dying state the new rule does not have become dead.
+ *
+ * @param rule
+ *      The rule to apply.
+ */
+void RangeWorld::set_rule(const RangeRule &rule)
+{
+    this->rule = rule;
+    for (CellState &cell : current_states)
+    {
+        if (cell >= rule.get_states())
+        {
+            cell = 0;
+        }
+    }
+}
+
+/**
+ * RangeWorld::build_area_sums(toroidal)
+ *
+ * Private helper function to build the summed-area table of the alive cells of the current state.
+ *
+ * The table covers the world padded by the range R on every side, (width + 2R) by (height + 2R) cells,
+ * with an extra row and column of zeros at the top and left. Entry (r, c) is the number of alive cells
+ * in the padded rows above r and columns left of c, built a row at a time from a running sum of the row
+ * and the entry above, so each entry costs the same for any range.
+ *
+ * @param toroidal
+ *      If true the padding holds the cells wrapped from the opposite edge, which may wrap more than once
+ *      when the range is larger than the world. If false the padding is dead.
+ */
+void RangeWorld::build_area_sums(const bool toroidal)
+{
+    const unsigned int range = rule.get_range();
+    const unsigned int padded_width = width + 2 * range;
+    const unsigned int padded_height = height + 2 * range;
+    const std::size_t stride = padded_width + 1;
+    area_sums.assign(stride * (padded_height + 1), 0);
+    for (unsigned int py = 0; py < padded_height; py++)
+    {
+        const std::uint32_t *above = area_sums.data() + std::size_t(py) * stride;
+        std::uint32_t *sums = area_sums.data() + std::size_t(py + 1) * stride;
+        const int y = int(py) - int(range);
+        std::uint32_t running = 0;
+        if (toroidal)
+        {
+            const CellState *row = current_states.data() + std::size_t(((y % int(height)) + height) % height) * width;
+            //step the wrapped column along with the padded one rather than taking a remainder per cell
+            unsigned int x = (width - range % width) % width;
+            for (unsigned int px = 0; px < padded_width; px++)
+            {
+                running += (row[x] == 1);
+                sums[px + 1] = above[px + 1] + running;
+                x = (x + 1 == width) ? 0 : x + 1;
+            }
+        }
+        else if (y < 0 || y >= int(height))
+        {
+            std::copy(above + 1, above + stride, sums + 1);
+        }
+        else
+        {
+            const CellState *row = current_states.data() + std::size_t(y) * width;
+            std::copy(above + 1, above + range + 1, sums + 1);
+            for (unsigned int x = 0; x < width; x++)
+            {
+                running += (row[x] == 1);
+                sums[range + x + 1] = above[range + x + 1] + running;
+            }
+            for (unsigned int px = range + width; px < padded_width; px++)
+            {
+                sums[px + 1] = above[px + 1] + running;
+            }
+        }
+    }
+}
+
+/**
+ * RangeWorld::count_neighbours(x, y)
+ *
+ * Private helper function to count the alive cells in the neighbourhood of a cell from the
+ * summed-area table, which must have been built for the current state. The cell's square starts
+ * at padded row y and column x, so it is summed from 4 corners without any edge checks.
+ *
+ * @param x
+ *      The x coordinate of the centre of the neighbourhood.
+ *
+ * @param y
+ *      The y coordinate of the centre of the neighbourhood.
+ *
+ * @return
+ *      Returns the number of alive neighbours, counting the cell itself only if the rule includes it.
+ */
+unsigned int RangeWorld::count_neighbours(const int x, const int y) const
+{
+    const unsigned int side = 2 * rule.get_range() + 1;
+    const std::size_t stride = width + side;
+    const std::uint32_t *top = area_sums.data() + std::size_t(y) * stride + x;
+    const std::uint32_t *bottom = top + side * stride;
+    const unsigned int count = bottom[side] - bottom[0] - top[side] + top[0];
+    return count - (!rule.get_middle() && current_states[std::size_t(y) * width + x] == 1);
+}
+
+/**
+ * RangeWorld::step(toroidal)
+ *
+ * Take one step of the rule. The summed-area table of the current state is built, then the next
+ * state of every cell is read from the rule with its count, see RangeRule::get_next, and the states swapped.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the world as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Defaults to false.
+ */
+void RangeWorld::step(const bool toroidal)
+{
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+    build_area_sums(toroidal);
+    alive_cells = 0;
+    for (unsigned int y = 0; y < height; y++)
+    {
+        const CellState *row = current_states.data() + std::size_t(y) * width;
+        CellState *next = next_states.data() + std::size_t(y) * width;
+        for (unsigned int x = 0; x < width; x++)
+        {
+            next[x] = rule.get_next(row[x], count_neighbours(x, y));
+            alive_cells += (next[x] == 1);
+        }
+    }
+    std::swap(current_states, next_states);
+}
+
+/**
+ * RangeWorld::advance(steps, toroidal)
+ *
+ * Advance multiple steps of the rule by invoking RangeWorld::step(toroidal).
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the steps will consider the world as a torus. Defaults to false.
+ */
+void RangeWorld::advance(const unsigned int steps, const bool toroidal)
+{
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        step(toroidal);
+    }
+}
+
+/**
+ * RangeWorld::to_grid()
+ *
+ * Make a Grid of the alive cells, so the world can be printed with a Renderer or saved with Zoo.
+ * Dying cells are dead in the grid.
+ *
+ * @return
+ *      A grid the size of the world.
+ */
+Grid RangeWorld::to_grid() const
+{
+    Grid grid(width, height);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            if (current_states[std::size_t(y) * width + x] == 1)
+            {
+                grid.set_unchecked(x, y, Cell::ALIVE);
+            }
+        }
+    }
+    return grid;
+}
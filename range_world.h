@@ -0,0 +1,98 @@
+/**
+ * Declares classes for running Larger than Life and Generations rules, whose cells see a neighbourhood
+ * of any range and can take more than two states.
+ * Rich documentation for the api and behaviour the RangeRule and RangeWorld classes can be found in range_world.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the classes.
+// #include ...
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+
+/**
+ * A CellState is the state of one cell of a RangeWorld, wider than the two valued Cell.
+ *      - 0 is dead and 1 is alive, the only state counted as a neighbour.
+ *      - 2 up to the number of states of the rule minus 1 are dying, counting up each generation
+ *        until the cell is dead again.
+ */
+typedef std::uint8_t CellState;
+
+/**
+ * Declare the structure of the RangeRule class, a Larger than Life or Generations rule.
+ * The neighbourhood is the (2 * range + 1) square around a cell, with or without the cell itself,
+ * and the counts that give birth or survival are stored as a lookup table for every possible count.
+ */
+class RangeRule
+{
+private:
+    unsigned int range;
+    unsigned int states;
+    bool middle;
+    std::vector<unsigned char> birth;
+    std::vector<unsigned char> survival;
+
+    void set_counts(std::vector<unsigned char> &counts, const std::string &ranges, const std::string &rule);
+
+public:
+    static const unsigned int MAX_RANGE = 500;
+
+    RangeRule();
+    explicit RangeRule(const Rule &rule, const unsigned int states = 2);
+    explicit RangeRule(const std::string &rule);
+
+    unsigned int get_range() const;
+    unsigned int get_states() const;
+    bool get_middle() const;
+    unsigned int get_max_count() const;
+    bool is_birth(const unsigned int count) const;
+    bool is_survival(const unsigned int count) const;
+    CellState get_next(const CellState state, const unsigned int count) const;
+};
+
+/**
+ * Declare the structure of the RangeWorld class, a 2d world of CellState cells stepped with a RangeRule.
+ * Neighbours are counted with a summed-area table of the alive cells, rebuilt each step, so counting
+ * costs the same for every cell whatever the range.
+ */
+class RangeWorld
+{
+private:
+    unsigned int width;
+    unsigned int height;
+    RangeRule rule;
+    std::vector<CellState> current_states;
+    std::vector<CellState> next_states;
+    std::vector<std::uint32_t> area_sums;
+    std::uint64_t alive_cells;
+
+    void build_area_sums(const bool toroidal);
+    unsigned int count_neighbours(const int x, const int y) const;
+
+public:
+    RangeWorld();
+    RangeWorld(const unsigned int width, const unsigned int height);
+    explicit RangeWorld(const Grid &initial_state);
+
+    int get_width() const;
+    int get_height() const;
+    std::uint64_t get_total_cells() const;
+    std::uint64_t get_alive_cells() const;
+
+    CellState get(const int x, const int y) const;
+    void set(const int x, const int y, const CellState state);
+
+    const RangeRule &get_rule() const;
+    void set_rule(const RangeRule &rule);
+
+    void step(const bool toroidal = false);
+    void advance(const unsigned int steps, const bool toroidal = false);
+
+    Grid to_grid() const;
+};
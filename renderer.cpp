@@ -0,0 +1,359 @@
+/**
+ * Implements a class for drawing grids of cells as ascii frames.
+ *      - Frames use the same format as operator<<, a border of - (dash), | (pipe), and + (plus)
+ *        characters around # (hash) for alive cells and ' ' (space) for dead cells.
+ *      - Each frame is built in a buffer owned by the renderer, reused from frame to frame, and
+ *        emitted to the stream with a single write.
+ *          - Rows are expanded from the packed cells 64 at a time rather than one get per cell.
+ *
+ *      - A viewport limits the frame to a window of the grid, clipped to the grid each frame
+ *        so it can be left in place while the world changes size.
+ *      - Grids can be cropped to the bounding box of their alive cells before drawing, so the frame
+ *        follows the live pattern without serializing the dead space around it.
+ *      - A block size of K downsamples the frame, drawing each KxK block of cells as one glyph
+ *        from ' ' (empty) through . : * to # (full) by the density of alive cells in the block.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "renderer.h"
+#include "bits.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * density_glyphs
+ *
+ * The glyphs for a downsampled block, from no alive cells to all alive cells.
+ */
+static const char density_glyphs[] = {' ', '.', ':', '*', '#'};
+static const unsigned int density_levels = sizeof(density_glyphs);
+
+/**
+ * Renderer::Renderer()
+ *
+ * Construct a renderer that draws every cell of the whole grid.
+ */
+Renderer::Renderer() : Renderer(1)
+{
+}
+
+/**
+ * Renderer::Renderer(block_size)
+ *
+ * Construct a renderer that draws the whole grid, downsampled so each KxK block is one glyph.
+ *
+ * @example
+ *
+ *      // Draw a 2000x2000 world as 50x50 glyphs
+ *      Renderer renderer(40);
+ *      renderer.write(std::cout, world.get_state());
+ *
+ * @param block_size
+ *      The edge size K of the block of cells drawn as each glyph, 1 draws every cell.
+ *
+ * @throws
+ *      std::invalid_argument if the block size is 0.
+ */
+Renderer::Renderer(const unsigned int block_size)
+    : block_size(1), has_viewport(false), crop_to_live(false),
+      viewport_x0(0), viewport_y0(0), viewport_x1(0), viewport_y1(0)
+{
+    set_block_size(block_size);
+}
+
+/**
+ * Renderer::get_block_size()
+ *
+ * Gets the edge size of the block of cells drawn as each glyph.
+ *
+ * @return
+ *      The block size, 1 if every cell is drawn.
+ */
+unsigned int Renderer::get_block_size() const
+{
+    return block_size;
+}
+
+/**
+ * Renderer::set_block_size(block_size)
+ *
+ * Sets the edge size of the block of cells drawn as each glyph.
+ *
+ * @param block_size
+ *      The block size, 1 draws every cell.
+ *
+ * @throws
+ *      std::invalid_argument if the block size is 0.
+ */
+void Renderer::set_block_size(const unsigned int block_size)
+{
+    if (block_size == 0)
+    {
+        throw std::invalid_argument("block size must be at least 1.");
+    }
+    this->block_size = block_size;
+}
+
+/**
+ * Renderer::set_viewport(x0, y0, x1, y1)
+ *
+ * Limit frames to the window [x0, x1) by [y0, y1) of the grid. The window is clipped to the grid
+ * when each frame is drawn, so it may extend past the edges.
+ *
+ * @example
+ *
+ *      // Only draw the top left 80x40 cells
+ *      Renderer renderer;
+ *      renderer.set_viewport(0, 0, 80, 40);
+ *
+ * @param x0
+ *      Left coordinate of the window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the window on y-axis (1 greater than the largest index).
+ */
+void Renderer::set_viewport(const int x0, const int y0, const int x1, const int y1)
+{
+    has_viewport = true;
+    viewport_x0 = x0;
+    viewport_y0 = y0;
+    viewport_x1 = x1;
+    viewport_y1 = y1;
+}
+
+/**
+ * Renderer::clear_viewport()
+ *
+ * Go back to drawing the whole grid.
+ */
+void Renderer::clear_viewport()
+{
+    has_viewport = false;
+}
+
+/**
+ * Renderer::get_crop_to_live()
+ *
+ * Gets whether grids are cropped to their live bounding box before drawing.
+ *
+ * @return
+ *      True if grids are cropped to their alive cells.
+ */
+bool Renderer::get_crop_to_live() const
+{
+    return crop_to_live;
+}
+
+/**
+ * Renderer::set_crop_to_live(crop)
+ *
+ * Sets whether grids are cropped to the bounding box of their alive cells before drawing.
+ * The crop applies when a Grid is drawn, any viewport is then taken relative to the live box.
+ * Views have no live box so are drawn as they are.
+ *
+ * @example
+ *
+ *      // Follow a glider across a huge world
+ *      Renderer renderer;
+ *      renderer.set_crop_to_live(true);
+ *      renderer.write(std::cout, world.get_state());
+ *
+ * @param crop
+ *      True to crop to the alive cells.
+ */
+void Renderer::set_crop_to_live(const bool crop)
+{
+    crop_to_live = crop;
+}
+
+/**
+ * Renderer::render(grid)
+ *
+ * Draw a frame of the grid into the renderer's buffer. The buffer is sized once for the whole
+ * frame and filled through a pointer, and keeps its capacity for the next frame.
+ *
+ * @example
+ *
+ *      // Draw the state of a world and keep the text
+ *      Renderer renderer;
+ *      std::string text = renderer.render(world.get_state());
+ *
+ * @param grid
+ *      The grid, or a view of part of a grid, to draw.
+ *
+ * @return
+ *      A reference to the frame, valid until the next call to render.
+ */
+const std::string &Renderer::render(const GridView &grid)
+{
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = grid.get_width();
+    int y1 = grid.get_height();
+    if (has_viewport)
+    {
+        x0 = std::min(std::max(viewport_x0, 0), grid.get_width());
+        y0 = std::min(std::max(viewport_y0, 0), grid.get_height());
+        x1 = std::min(std::max(viewport_x1, x0), grid.get_width());
+        y1 = std::min(std::max(viewport_y1, y0), grid.get_height());
+    }
+    const GridView view = grid.crop(x0, y0, x1, y1);
+
+    const unsigned int width = view.get_width();
+    const unsigned int height = view.get_height();
+    const unsigned int columns = (width + block_size - 1) / block_size;
+    const unsigned int rows = (height + block_size - 1) / block_size;
+
+    //every line is a pipe or plus at each end then a newline
+    frame.resize(std::size_t(columns + 3) * (rows + 2));
+    char *out = &frame[0];
+
+    //first line
+    *out++ = '+';
+    out = std::fill_n(out, columns, '-');
+    *out++ = '+';
+    *out++ = '\n';
+
+    //main body
+    for (unsigned int r = 0; r < rows; r++)
+    {
+        *out++ = '|';
+        if (block_size == 1)
+        {
+            //expand the packed row 64 cells at a time
+            const std::uint64_t *row = view.get_row(r);
+            for (unsigned int x = 0; x < width; x += 64)
+            {
+                const unsigned int count = std::min(64u, width - x);
+                const std::uint64_t bits = read_bits(row, view.get_offset() + x, count);
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    *out++ = ((bits >> i) & 1) ? Cell::ALIVE : Cell::DEAD;
+                }
+            }
+        }
+        else
+        {
+            //count the alive cells of each block in this band of rows, visiting only set bits
+            block_counts.assign(columns, 0);
+            const unsigned int band_height = std::min(block_size, height - r * block_size);
+            for (unsigned int y = r * block_size; y < r * block_size + band_height; y++)
+            {
+                const std::uint64_t *row = view.get_row(y);
+                for (unsigned int x = 0; x < width; x += 64)
+                {
+                    std::uint64_t bits = read_bits(row, view.get_offset() + x, std::min(64u, width - x));
+                    while (bits != 0)
+                    {
+                        const std::uint64_t lowest = bits & (~bits + 1);
+                        block_counts[(x + count_bits(lowest - 1)) / block_size]++;
+                        bits ^= lowest;
+                    }
+                }
+            }
+
+            //any alive cell shows at least the faintest glyph, only a full block shows the densest
+            for (unsigned int c = 0; c < columns; c++)
+            {
+                //a block can hold 2^32 cells or more, so its area and count need 64 bits
+                const std::uint64_t area = std::uint64_t(std::min(block_size, width - c * block_size)) * band_height;
+                const std::uint64_t count = block_counts[c];
+                const unsigned int level = (count == 0) ? 0 : 1 + (count * (density_levels - 2)) / area;
+                *out++ = density_glyphs[level];
+            }
+        }
+        *out++ = '|';
+        *out++ = '\n';
+    }
+
+    //final line
+    *out++ = '+';
+    out = std::fill_n(out, columns, '-');
+    *out++ = '+';
+    *out++ = '\n';
+
+    return frame;
+}
+
+/**
+ * Renderer::render(grid)
+ *
+ * Draw a frame of a grid into the renderer's buffer, cropped to its live bounding box if enabled.
+ * Tiled grids are converted to a row major copy first.
+ *
+ * @param grid
+ *      The grid to draw.
+ *
+ * @return
+ *      A reference to the frame, valid until the next call to render.
+ */
+const std::string &Renderer::render(const Grid &grid)
+{
+    if (grid.get_layout() == Layout::TILED)
+    {
+        return render(grid.to_layout(Layout::ROW_MAJOR));
+    }
+    else if (crop_to_live)
+    {
+        return render(grid.live_view());
+    }
+    return render(GridView(grid));
+}
+
+/**
+ * Renderer::write(output_stream, grid)
+ *
+ * Draw a frame of a grid, cropped to its live bounding box if enabled, and send it to an
+ * output stream with a single write.
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param grid
+ *      The grid to draw.
+ *
+ * @return
+ *      Returns a reference to the output stream to enable operator chaining.
+ */
+std::ostream &Renderer::write(std::ostream &os, const Grid &grid)
+{
+    const std::string &text = render(grid);
+    return os.write(text.data(), text.size());
+}
+
+/**
+ * Renderer::write(output_stream, grid)
+ *
+ * Draw a frame of the grid and send it to an output stream with a single write.
+ *
+ * @example
+ *
+ *      // Print only the centre of a huge world, 4x4 cells per glyph
+ *      Renderer renderer(4);
+ *      renderer.set_viewport(900, 900, 1100, 1100);
+ *      renderer.write(std::cout, world.get_state()) << std::endl;
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param grid
+ *      The grid, or a view of part of a grid, to draw.
+ *
+ * @return
+ *      Returns a reference to the output stream to enable operator chaining.
+ */
+std::ostream &Renderer::write(std::ostream &os, const GridView &grid)
+{
+    const std::string &text = render(grid);
+    return os.write(text.data(), text.size());
+}
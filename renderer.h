@@ -0,0 +1,52 @@
+/**
+ * Declares a class for drawing grids of cells as ascii frames.
+ * Rich documentation for the api and behaviour the Renderer class can be found in renderer.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the structure of the Renderer class, which builds each ascii frame in a reusable buffer,
+ * optionally limited to a viewport and downsampled so each KxK block of cells is one glyph.
+ */
+class Renderer
+{
+private:
+    unsigned int block_size;
+    bool has_viewport;
+    bool crop_to_live;
+    int viewport_x0;
+    int viewport_y0;
+    int viewport_x1;
+    int viewport_y1;
+    std::string frame;
+    std::vector<std::uint64_t> block_counts;
+
+public:
+    Renderer();
+    explicit Renderer(const unsigned int block_size);
+
+    unsigned int get_block_size() const;
+    void set_block_size(const unsigned int block_size);
+
+    void set_viewport(const int x0, const int y0, const int x1, const int y1);
+    void clear_viewport();
+
+    bool get_crop_to_live() const;
+    void set_crop_to_live(const bool crop);
+
+    const std::string &render(const GridView &grid);
+    const std::string &render(const Grid &grid);
+    std::ostream &write(std::ostream &os, const GridView &grid);
+    std::ostream &write(std::ostream &os, const Grid &grid);
+};
@@ -0,0 +1,234 @@
+/**
+ * Implements a class representing a Life-like cellular automaton rule.
+ *      - A Life-like rule decides the next state of a cell from its own state and the number of its
+ *        8 neighbours that are alive, and nothing else.
+ *          - B lists the neighbour counts that make a dead cell alive, S the counts that keep an alive cell alive.
+ *          - Conway's Game of Life is B3/S23, HighLife B36/S23, Day & Night B3678/S34678, Seeds B2/S.
+ *
+ *      - Rules are parsed from B/S strings such as "B36/S23", in either order and either case, or from
+ *        the older S/B form such as "23/36" with the survival counts first.
+ *          - https://conwaylife.com/wiki/Rulestring
+ *
+ *      - Rules are stored as two 9 bit masks so the step engines can specialize on them at compile time.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "rule.h"
+#include <cctype>
+#include <stdexcept>
+
+/**
+ * Rule::Rule()
+ *
+ * Construct the rule of Conway's Game of Life, B3/S23.
+ */
+Rule::Rule() : Rule(CONWAY_BIRTH, CONWAY_SURVIVAL)
+{
+    //pass to mask constructor
+}
+
+/**
+ * Rule::Rule(birth, survival)
+ *
+ * Construct a rule from its masks, bit n of each set for n alive neighbours.
+ *
+ * @example
+ *
+ *      // Make HighLife, B36/S23
+ *      Rule highlife((1 << 3) | (1 << 6), (1 << 2) | (1 << 3));
+ *
+ * @param birth
+ *      The neighbour counts that make a dead cell alive. Bits past 8 are ignored.
+ *
+ * @param survival
+ *      The neighbour counts that keep an alive cell alive. Bits past 8 are ignored.
+ */
+Rule::Rule(const std::uint16_t birth, const std::uint16_t survival)
+    : birth(birth & 0x1FF), survival(survival & 0x1FF)
+{
+}
+
+/**
+ * Rule::Rule(rule)
+ *
+ * Construct a rule from a rule string, either "B<digits>/S<digits>" in either order and either case,
+ * or "<survival digits>/<birth digits>". Either list of digits may be empty.
+ *
+ * @example
+ *
+ *      // Make Day & Night
+ *      Rule day_and_night("B3678/S34678");
+ *
+ *      // Make Conway's Game of Life in S/B form
+ *      Rule conway("23/3");
+ *
+ * @param rule
+ *      The rule string.
+ *
+ * @throws
+ *      std::invalid_argument if the string is not a valid Life-like rule.
+ */
+Rule::Rule(const std::string &rule) : birth(0), survival(0)
+{
+    const std::size_t slash = rule.find('/');
+    if (slash == std::string::npos || rule.find('/', slash + 1) != std::string::npos)
+    {
+        throw std::invalid_argument("rule " + rule + " must have two parts split by /.");
+    }
+    const std::string parts[2] = {rule.substr(0, slash), rule.substr(slash + 1)};
+    //without letters the survival counts come first
+    const bool lettered = !parts[0].empty() && std::isalpha((unsigned char)parts[0][0]);
+    bool seen[2] = {false, false};
+    for (unsigned int p = 0; p < 2; p++)
+    {
+        std::string digits = parts[p];
+        bool is_birth = (p == 1);
+        if (lettered)
+        {
+            const char letter = digits.empty() ? 0 : std::toupper((unsigned char)digits[0]);
+            if (letter != 'B' && letter != 'S')
+            {
+                throw std::invalid_argument("rule " + rule + " must label both parts with B or S.");
+            }
+            is_birth = (letter == 'B');
+            digits = digits.substr(1);
+        }
+        if (seen[is_birth])
+        {
+            throw std::invalid_argument("rule " + rule + " must have one B and one S part.");
+        }
+        seen[is_birth] = true;
+
+        std::uint16_t &mask = is_birth ? birth : survival;
+        for (const char digit : digits)
+        {
+            if (digit < '0' || digit > '8' || ((mask >> (digit - '0')) & 1))
+            {
+                throw std::invalid_argument("rule " + rule + " must list each neighbour count 0 to 8 at most once.");
+            }
+            mask |= 1 << (digit - '0');
+        }
+    }
+}
+
+/**
+ * Rule::get_birth()
+ *
+ * Gets the neighbour counts that make a dead cell alive.
+ *
+ * @return
+ *      The birth mask, bit n set for n neighbours.
+ */
+std::uint16_t Rule::get_birth() const
+{
+    return birth;
+}
+
+/**
+ * Rule::get_survival()
+ *
+ * Gets the neighbour counts that keep an alive cell alive.
+ *
+ * @return
+ *      The survival mask, bit n set for n neighbours.
+ */
+std::uint16_t Rule::get_survival() const
+{
+    return survival;
+}
+
+/**
+ * Rule::is_conway()
+ *
+ * Checks whether this is Conway's Game of Life, B3/S23, which has its own hand tuned kernels.
+ *
+ * @return
+ *      True if the rule is B3/S23.
+ */
+bool Rule::is_conway() const
+{
+    return birth == CONWAY_BIRTH && survival == CONWAY_SURVIVAL;
+}
+
+/**
+ * Rule::get_next(alive, neighbours)
+ *
+ * Gets the next state of a single cell.
+ *
+ * @param alive
+ *      True if the cell is alive now.
+ *
+ * @param neighbours
+ *      The number of alive neighbours, 0 to 8.
+ *
+ * @return
+ *      True if the cell is alive next generation.
+ */
+bool Rule::get_next(const bool alive, const unsigned int neighbours) const
+{
+    return (((alive ? survival : birth) >> neighbours) & 1) != 0;
+}
+
+/**
+ * Rule::to_string()
+ *
+ * Gets the rule in B/S notation with the counts in increasing order.
+ *
+ * @example
+ *
+ *      // Prints B36/S23
+ *      std::cout << Rule("23/36").to_string() << std::endl;
+ *
+ * @return
+ *      The rule string.
+ */
+std::string Rule::to_string() const
+{
+    std::string text = "B";
+    for (unsigned int n = 0; n <= 8; n++)
+    {
+        if ((birth >> n) & 1)
+        {
+            text += char('0' + n);
+        }
+    }
+    text += "/S";
+    for (unsigned int n = 0; n <= 8; n++)
+    {
+        if ((survival >> n) & 1)
+        {
+            text += char('0' + n);
+        }
+    }
+    return text;
+}
+
+/**
+ * Rule::operator==(other)
+ *
+ * Compare two rules, which are equal when they have the same birth and survival counts.
+ *
+ * @return
+ *      True if the rules are equal.
+ */
+bool Rule::operator==(const Rule &other) const
+{
+    return birth == other.birth && survival == other.survival;
+}
+
+/**
+ * Rule::operator!=(other)
+ *
+ * Compare two rules, see Rule::operator==.
+ *
+ * @return
+ *      True if the rules differ.
+ */
+bool Rule::operator!=(const Rule &other) const
+{
+    return !(*this == other);
+}
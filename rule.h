@@ -0,0 +1,41 @@
+/**
+ * Declares a class representing a Life-like cellular automaton rule in B/S notation.
+ * Rich documentation for the api and behaviour the Rule class can be found in rule.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <string>
+
+/**
+ * Declare the structure of the Rule class, which holds the neighbour counts (0 to 8) that make a dead
+ * cell alive and keep an alive cell alive as two 9 bit masks, bit n set for n neighbours.
+ */
+class Rule
+{
+private:
+    std::uint16_t birth;
+    std::uint16_t survival;
+
+public:
+    static const std::uint16_t CONWAY_BIRTH = 1 << 3;
+    static const std::uint16_t CONWAY_SURVIVAL = (1 << 2) | (1 << 3);
+
+    Rule();
+    Rule(const std::uint16_t birth, const std::uint16_t survival);
+    explicit Rule(const std::string &rule);
+
+    std::uint16_t get_birth() const;
+    std::uint16_t get_survival() const;
+    bool is_conway() const;
+    bool get_next(const bool alive, const unsigned int neighbours) const;
+    std::string to_string() const;
+
+    bool operator==(const Rule &other) const;
+    bool operator!=(const Rule &other) const;
+};
@@ -0,0 +1,780 @@
+/**
+ * Implements a class representing a huge, mostly empty 2d grid of cells.
+ *      - The grid is split into 64x64 tiles, each packing a row of the tile into one word.
+ *      - Tiles live in a hash map keyed by tile coordinate, and only tiles with at least one alive
+ *        cell are stored, so memory and scan time scale with the live region rather than width * height.
+ *          - Setting the first alive cell in a tile creates it, killing its last alive cell removes it.
+ *          - Reading a cell of a missing tile gives Cell::DEAD.
+ *
+ *      - The api mirrors Grid, with get, set, crop, merge, and the cell counts.
+ *          - Counts are 64 bit since a sparse grid can cover far more than 2^32 cells.
+ *          - Any Grid or GridView can be merged in, and a SparseGrid can be expanded into a Grid.
+ *          - Occupied tiles can be iterated with a range based for loop.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "sparse_grid.h"
+#include "bits.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * SparseGrid::SparseGrid()
+ *
+ * Construct an empty sparse grid of size 0x0.
+ */
+SparseGrid::SparseGrid() : SparseGrid(0, 0)
+{
+}
+
+/**
+ * SparseGrid::SparseGrid(square_size)
+ *
+ * Construct a sparse grid with the desired size filled with dead cells.
+ *
+ * @param square_size
+ *      The edge size to use for the width and height of the grid.
+ */
+SparseGrid::SparseGrid(const unsigned int square_size) : SparseGrid(square_size, square_size)
+{
+}
+
+/**
+ * SparseGrid::SparseGrid(width, height)
+ *
+ * Construct a sparse grid with the desired size filled with dead cells. No memory is used for
+ * cells until they are made alive, so the grid can be as large as the coordinates allow.
+ *
+ * @example
+ *
+ *      // Make a grid a million cells on each side
+ *      SparseGrid grid(1000000, 1000000);
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ */
+SparseGrid::SparseGrid(const unsigned int width, const unsigned int height)
+    : width(width), height(height), alive_cells(0)
+{
+}
+
+/**
+ * SparseGrid::SparseGrid(view)
+ *
+ * Construct a sparse grid holding a copy of the cells of a Grid or GridView.
+ *
+ * @example
+ *
+ *      // Make a sparse copy of a glider
+ *      SparseGrid grid(Zoo::glider());
+ *
+ * @param view
+ *      The cells to copy.
+ */
+SparseGrid::SparseGrid(const GridView &view) : SparseGrid(view.get_width(), view.get_height())
+{
+    merge(view, 0, 0);
+}
+
+/**
+ * SparseGrid::SparseGrid(grid)
+ *
+ * Construct a sparse grid holding a copy of the cells of a Grid of either layout, see SparseGrid::merge(grid, ...).
+ *
+ * @param grid
+ *      The cells to copy.
+ */
+SparseGrid::SparseGrid(const Grid &grid) : SparseGrid(grid.get_width(), grid.get_height())
+{
+    merge(grid, 0, 0);
+}
+
+/**
+ * SparseGrid::get_width()
+ *
+ * Gets the current width of the grid.
+ *
+ * @return
+ *      The width of the grid.
+ */
+int SparseGrid::get_width() const
+{
+    return width;
+}
+
+/**
+ * SparseGrid::get_height()
+ *
+ * Gets the current height of the grid.
+ *
+ * @return
+ *      The height of the grid.
+ */
+int SparseGrid::get_height() const
+{
+    return height;
+}
+
+/**
+ * SparseGrid::get_total_cells()
+ *
+ * Gets the total number of cells in the grid, alive or dead.
+ *
+ * @return
+ *      The number of cells in the grid.
+ */
+std::uint64_t SparseGrid::get_total_cells() const
+{
+    return std::uint64_t(width) * height;
+}
+
+/**
+ * SparseGrid::get_alive_cells()
+ *
+ * Gets the number of alive cells in the grid. The count is maintained by every write, so this is O(1).
+ *
+ * @return
+ *      The number of alive cells.
+ */
+std::uint64_t SparseGrid::get_alive_cells() const
+{
+    return alive_cells;
+}
+
+/**
+ * SparseGrid::get_dead_cells()
+ *
+ * Gets the number of dead cells in the grid.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+std::uint64_t SparseGrid::get_dead_cells() const
+{
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * SparseGrid::get_tile_count()
+ *
+ * Gets the number of tiles currently stored, each holding at least one alive cell.
+ *
+ * @return
+ *      The number of occupied tiles.
+ */
+std::size_t SparseGrid::get_tile_count() const
+{
+    return tiles.size();
+}
+
+/**
+ * SparseGrid::get_key(tile_x, tile_y)
+ *
+ * Private helper function to pack tile coordinates into a hash map key.
+ *
+ * @return
+ *      The key of the tile.
+ */
+std::uint64_t SparseGrid::get_key(const unsigned int tile_x, const unsigned int tile_y)
+{
+    return (std::uint64_t(tile_y) << 32) | tile_x;
+}
+
+/**
+ * SparseGrid::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      SparseGrid grid(100000, 100000);
+ *
+ *      // Read the cell at x=5000, y=70000
+ *      Cell value = grid.get(5000, 70000);
+ *
+ * @param x
+ *      The x coordinate of the cell to update.
+ *
+ * @param y
+ *      The y coordinate of the cell to update.
+ *
+ * @return
+ *      The value of the desired cell. Should only be Grid::ALIVE or Grid::DEAD.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+Cell SparseGrid::get(const int x, const int y) const
+{
+    if (x < 0 || x >= get_width() || y < 0 || y >= get_height())
+    {
+        throw std::out_of_range("get is out of bounds.");
+    }
+
+    const std::unordered_map<std::uint64_t, Tile>::const_iterator found = tiles.find(get_key(x / TILE_SIZE, y / TILE_SIZE));
+    if (found == tiles.end())
+    {
+        return Cell::DEAD;
+    }
+    return ((found->second.rows[y % TILE_SIZE] >> (x % TILE_SIZE)) & 1) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * SparseGrid::set(x, y, value)
+ *
+ * Overwrites the value at the desired coordinate, creating or removing its tile as needed.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      SparseGrid grid(100000, 100000);
+ *
+ *      // Make the cell at x=5000, y=70000 alive, allocating a single tile
+ *      grid.set(5000, 70000, Cell::ALIVE);
+ *
+ * @param x
+ *      The x coordinate of the cell to update.
+ *
+ * @param y
+ *      The y coordinate of the cell to update.
+ *
+ * @param value
+ *      The value to set the cell to.
+ *
+ * @throws
+ *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
+ */
+void SparseGrid::set(const int x, const int y, const Cell value)
+{
+    if (x < 0 || x >= get_width() || y < 0 || y >= get_height())
+    {
+        throw std::out_of_range("set is out of bounds.");
+    }
+    write_tile_bits(x / TILE_SIZE, y, x % TILE_SIZE, value == Cell::ALIVE, 1, false);
+}
+
+/**
+ * SparseGrid::write_bits(x, y, bits, count, alive_only)
+ *
+ * Private helper function to write up to 64 consecutive cells of a row, which may straddle two tiles.
+ *
+ * @param x
+ *      The x coordinate of the first cell.
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @param bits
+ *      The cells to write, the first in the lowest bit. Bits past count are ignored.
+ *
+ * @param count
+ *      The number of cells to write, from 1 to 64.
+ *
+ * @param alive_only
+ *      If true only alive cells are written, dead cells leave the existing value.
+ */
+void SparseGrid::write_bits(const unsigned int x, const unsigned int y, std::uint64_t bits,
+                            const unsigned int count, const bool alive_only)
+{
+    const unsigned int shift = x % TILE_SIZE;
+    const unsigned int first = (count < TILE_SIZE - shift) ? count : TILE_SIZE - shift;
+    write_tile_bits(x / TILE_SIZE, y, shift, bits, first, alive_only);
+    if (first < count)
+    {
+        write_tile_bits(x / TILE_SIZE + 1, y, 0, bits >> first, count - first, alive_only);
+    }
+}
+
+/**
+ * SparseGrid::write_tile_bits(tile_x, y, shift, bits, count, alive_only)
+ *
+ * Private helper function to write consecutive cells within the row of a single tile.
+ * Creates the tile if an alive cell is written to it, and removes it once it has no alive cells.
+ *
+ * @param tile_x
+ *      The column of tiles holding the cells.
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @param shift
+ *      The x coordinate of the first cell within the tile.
+ *
+ * @param bits
+ *      The cells to write, the first in the lowest bit. Bits past count are ignored.
+ *
+ * @param count
+ *      The number of cells to write, at most 64 - shift.
+ *
+ * @param alive_only
+ *      If true only alive cells are written, dead cells leave the existing value.
+ */
+void SparseGrid::write_tile_bits(const unsigned int tile_x, const unsigned int y, const unsigned int shift,
+                                 std::uint64_t bits, const unsigned int count, const bool alive_only)
+{
+    const std::uint64_t mask = ((count == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1)) << shift;
+    bits = (bits << shift) & mask;
+
+    std::unordered_map<std::uint64_t, Tile>::iterator found = tiles.find(get_key(tile_x, y / TILE_SIZE));
+    if (found == tiles.end())
+    {
+        //writing dead cells into a missing tile changes nothing
+        if (bits == 0)
+        {
+            return;
+        }
+        Tile tile;
+        tile.x = tile_x * TILE_SIZE;
+        tile.y = (y / TILE_SIZE) * TILE_SIZE;
+        tile.alive_cells = 0;
+        std::memset(tile.rows, 0, sizeof(tile.rows));
+        found = tiles.emplace(get_key(tile_x, y / TILE_SIZE), tile).first;
+    }
+
+    Tile &tile = found->second;
+    std::uint64_t &row = tile.rows[y % TILE_SIZE];
+    const unsigned int before = count_bits(row);
+    row = alive_only ? (row | bits) : ((row & ~mask) | bits);
+    const unsigned int after = count_bits(row);
+
+    tile.alive_cells = tile.alive_cells + after - before;
+    alive_cells = alive_cells + after - before;
+    if (tile.alive_cells == 0)
+    {
+        tiles.erase(found);
+    }
+}
+
+/**
+ * SparseGrid::clear(x0, y0, x1, y1)
+ *
+ * Private helper function to kill every cell in the range [x0, x1) by [y0, y1),
+ * removing any tiles left empty.
+ */
+void SparseGrid::clear(const unsigned int x0, const unsigned int y0, const unsigned int x1, const unsigned int y1)
+{
+    for (std::unordered_map<std::uint64_t, Tile>::iterator it = tiles.begin(); it != tiles.end();)
+    {
+        Tile &tile = it->second;
+        const unsigned int tile_x = tile.x;
+        const unsigned int tile_y = tile.y;
+        if (tile_x + TILE_SIZE <= x0 || tile_x >= x1 || tile_y + TILE_SIZE <= y0 || tile_y >= y1)
+        {
+            ++it;
+            continue;
+        }
+
+        //mask covering the columns of the tile inside the range
+        const unsigned int lo = (x0 > tile_x) ? x0 - tile_x : 0;
+        const unsigned int hi = (x1 < tile_x + TILE_SIZE) ? x1 - tile_x : TILE_SIZE;
+        const std::uint64_t mask = ((hi - lo == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << (hi - lo)) - 1)) << lo;
+
+        const unsigned int top = (y0 > tile_y) ? y0 - tile_y : 0;
+        const unsigned int bottom = (y1 < tile_y + TILE_SIZE) ? y1 - tile_y : TILE_SIZE;
+        for (unsigned int r = top; r < bottom; r++)
+        {
+            const unsigned int killed = count_bits(tile.rows[r] & mask);
+            tile.rows[r] &= ~mask;
+            tile.alive_cells -= killed;
+            alive_cells -= killed;
+        }
+
+        if (tile.alive_cells == 0)
+        {
+            it = tiles.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/**
+ * SparseGrid::crop(x0, y0, x1, y1)
+ *
+ * Extract a sub-grid from the sparse grid, the range [x0, x1) by [y0, y1), as another sparse grid.
+ * Visits either the occupied tiles or the tiles covering the window, whichever there are fewer of.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a huge grid
+ *      SparseGrid x(1000000, 1000000);
+ *
+ *      // Take out a 1000x1000 window, and expand it into a dense grid
+ *      Grid y = x.crop(5000, 5000, 6000, 6000).to_grid();
+ *
+ * @param x0
+ *      Left coordinate of the crop window on x-axis.
+ *
+ * @param y0
+ *      Top coordinate of the crop window on y-axis.
+ *
+ * @param x1
+ *      Right coordinate of the crop window on x-axis (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
+ *
+ * @return
+ *      A new sparse grid of the cropped size containing the values extracted from the original grid.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
+ *      or if the crop window has a negative size.
+ */
+SparseGrid SparseGrid::crop(const int x0, const int y0, const int x1, const int y1) const
+{
+    if (x0 < 0 || x0 > x1 || y0 < 0 || y0 > y1 || x1 > get_width() || y1 > get_height())
+    {
+        throw std::out_of_range("crop out of bounds.");
+    }
+
+    SparseGrid cropped(x1 - x0, y1 - y0);
+    if (x0 == x1 || y0 == y1)
+    {
+        return cropped;
+    }
+
+    //copy the part of a tile inside the window, row by row
+    auto copy_tile = [&](const Tile &tile)
+    {
+        const int lo = std::max(x0, tile.x) - tile.x;
+        const int hi = std::min<int>(x1, tile.x + TILE_SIZE) - tile.x;
+        const int top = std::max(y0, tile.y) - tile.y;
+        const int bottom = std::min<int>(y1, tile.y + TILE_SIZE) - tile.y;
+        for (int r = top; r < bottom; r++)
+        {
+            const std::uint64_t bits = tile.rows[r] >> lo;
+            if (bits != 0)
+            {
+                cropped.write_bits(tile.x + lo - x0, tile.y + r - y0, bits, hi - lo, true);
+            }
+        }
+    };
+
+    const unsigned int first_x = x0 / TILE_SIZE;
+    const unsigned int last_x = (x1 - 1) / TILE_SIZE;
+    const unsigned int first_y = y0 / TILE_SIZE;
+    const unsigned int last_y = (y1 - 1) / TILE_SIZE;
+    const std::uint64_t window_tiles = std::uint64_t(last_x - first_x + 1) * (last_y - first_y + 1);
+    if (window_tiles < tiles.size())
+    {
+        for (unsigned int tile_y = first_y; tile_y <= last_y; tile_y++)
+        {
+            for (unsigned int tile_x = first_x; tile_x <= last_x; tile_x++)
+            {
+                const std::unordered_map<std::uint64_t, Tile>::const_iterator found = tiles.find(get_key(tile_x, tile_y));
+                if (found != tiles.end())
+                {
+                    copy_tile(found->second);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const std::pair<const std::uint64_t, Tile> &entry : tiles)
+        {
+            const Tile &tile = entry.second;
+            if (tile.x < x1 && tile.x + int(TILE_SIZE) > x0 && tile.y < y1 && tile.y + int(TILE_SIZE) > y0)
+            {
+                copy_tile(tile);
+            }
+        }
+    }
+    return cropped;
+}
+
+/**
+ * SparseGrid::merge(other, x0, y0, alive_only = false)
+ *
+ * Overlay the cells of a Grid or GridView on the sparse grid at the desired location,
+ * 64 cells at a time. Dead regions of the other grid do not create any tiles.
+ *
+ * Conditionally if alive_only = true perform the merge such that only alive cells are updated.
+ *
+ * @example
+ *
+ *      // Make a huge grid
+ *      SparseGrid grid(1000000, 1000000);
+ *
+ *      // Place a glider in the middle
+ *      grid.merge(Zoo::glider(), 500000, 500000);
+ *
+ * @param other
+ *      The grid, or a view of part of a grid, to merge into the sparse grid.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive but does not explicitly set
+ *      dead cells, allowing whatever value was already there to persist. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void SparseGrid::merge(const GridView &other, const int x0, const int y0, const bool alive_only)
+{
+    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
+    {
+        throw std::out_of_range("merge out of bounds.");
+    }
+
+    for (int y = 0; y < other.get_height(); y++)
+    {
+        const std::uint64_t *row = other.get_row(y);
+        for (int x = 0; x < other.get_width(); x += 64)
+        {
+            const unsigned int count = std::min(64, other.get_width() - x);
+            write_bits(x0 + x, y0 + y, read_bits(row, other.get_offset() + x, count), count, alive_only);
+        }
+    }
+}
+
+/**
+ * SparseGrid::merge(other, x0, y0, alive_only = false)
+ *
+ * Merge a grid into the sparse grid, as SparseGrid::merge(view, x0, y0, alive_only).
+ * A tiled grid cannot be viewed, so it is converted to a row major copy first.
+ *
+ * @param other
+ *      The grid to merge into the sparse grid.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void SparseGrid::merge(const Grid &other, const int x0, const int y0, const bool alive_only)
+{
+    if (other.get_layout() == Layout::TILED)
+    {
+        merge(GridView(other.to_layout(Layout::ROW_MAJOR)), x0, y0, alive_only);
+    }
+    else
+    {
+        merge(GridView(other), x0, y0, alive_only);
+    }
+}
+
+/**
+ * SparseGrid::merge(other, x0, y0, alive_only = false)
+ *
+ * Overlay another sparse grid on this one at the desired location, visiting only its occupied tiles.
+ * Unless alive_only is set, the covered region is cleared first so dead cells overwrite too.
+ *
+ * @example
+ *
+ *      // Make two sparse grids
+ *      SparseGrid x(100, 100), y(1000000, 1000000);
+ *
+ *      // Overlay x at 250000,250000 in y
+ *      y.merge(x, 250000, 250000);
+ *
+ * @param other
+ *      The sparse grid to merge into the current grid.
+ *
+ * @param x0
+ *      The x coordinate of where to place the top left corner of the other grid.
+ *
+ * @param y0
+ *      The y coordinate of where to place the top left corner of the other grid.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then merging only sets alive cells to alive but does not explicitly set
+ *      dead cells, allowing whatever value was already there to persist. Defaults to false.
+ *
+ * @throws
+ *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
+ */
+void SparseGrid::merge(const SparseGrid &other, const int x0, const int y0, const bool alive_only)
+{
+    if (x0 < 0 || x0 + other.get_width() > get_width() || y0 < 0 || y0 + other.get_height() > get_height())
+    {
+        throw std::out_of_range("merge out of bounds.");
+    }
+    else if (&other == this)
+    {
+        //tiles would be changing underneath the iteration
+        merge(SparseGrid(other), x0, y0, alive_only);
+        return;
+    }
+
+    if (!alive_only)
+    {
+        clear(x0, y0, x0 + other.get_width(), y0 + other.get_height());
+    }
+    for (const std::pair<const std::uint64_t, Tile> &entry : other.tiles)
+    {
+        const Tile &tile = entry.second;
+        const unsigned int count = (other.width - tile.x < TILE_SIZE) ? other.width - tile.x : TILE_SIZE;
+        for (unsigned int r = 0; r < TILE_SIZE; r++)
+        {
+            if (tile.rows[r] != 0)
+            {
+                write_bits(x0 + tile.x, y0 + tile.y + r, tile.rows[r], count, true);
+            }
+        }
+    }
+}
+
+/**
+ * SparseGrid::to_grid()
+ *
+ * Expand the sparse grid into a dense Grid of the same size, copying each occupied tile a word per row.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a sparse grid and place a glider in it
+ *      SparseGrid sparse(200, 200);
+ *      sparse.merge(Zoo::glider(), 100, 100);
+ *
+ *      // Print it
+ *      std::cout << sparse.to_grid() << std::endl;
+ *
+ * @return
+ *      A grid holding the same cells.
+ */
+Grid SparseGrid::to_grid() const
+{
+    Grid grid(width, height);
+    for (const std::pair<const std::uint64_t, Tile> &entry : tiles)
+    {
+        const Tile &tile = entry.second;
+        for (unsigned int r = 0; r < TILE_SIZE && tile.y + r < height; r++)
+        {
+            //tiles and grid rows are both aligned to 64 cells, so each tile row is one grid word
+            grid.get_row(tile.y + r)[tile.x / TILE_SIZE] = tile.rows[r];
+        }
+    }
+    return grid;
+}
+
+/**
+ * SparseGrid::begin()
+ *
+ * Gets an iterator to the first occupied tile, so the grid can be scanned tile by tile.
+ * Tiles are visited in no particular order.
+ *
+ * @example
+ *
+ *      // Count the alive cells in the top row of every occupied tile
+ *      for (const SparseGrid::Tile &tile : grid)
+ *      {
+ *          total += __builtin_popcountll(tile.rows[0]);
+ *      }
+ *
+ * @return
+ *      An iterator to the first occupied tile.
+ */
+SparseGrid::const_iterator SparseGrid::begin() const
+{
+    return const_iterator(tiles.begin());
+}
+
+/**
+ * SparseGrid::end()
+ *
+ * Gets the iterator past the last occupied tile.
+ *
+ * @return
+ *      The end iterator.
+ */
+SparseGrid::const_iterator SparseGrid::end() const
+{
+    return const_iterator(tiles.end());
+}
+
+/**
+ * SparseGrid::const_iterator::const_iterator(position)
+ *
+ * Wrap a position in the tile map.
+ *
+ * @param position
+ *      The position in the tile map.
+ */
+SparseGrid::const_iterator::const_iterator(std::unordered_map<std::uint64_t, Tile>::const_iterator position)
+    : position(position)
+{
+}
+
+/**
+ * SparseGrid::const_iterator::operator*()
+ *
+ * @return
+ *      The current tile.
+ */
+const SparseGrid::Tile &SparseGrid::const_iterator::operator*() const
+{
+    return position->second;
+}
+
+/**
+ * SparseGrid::const_iterator::operator->()
+ *
+ * @return
+ *      A pointer to the current tile.
+ */
+const SparseGrid::Tile *SparseGrid::const_iterator::operator->() const
+{
+    return &position->second;
+}
+
+/**
+ * SparseGrid::const_iterator::operator++()
+ *
+ * Move to the next occupied tile.
+ *
+ * @return
+ *      A reference to this iterator.
+ */
+SparseGrid::const_iterator &SparseGrid::const_iterator::operator++()
+{
+    ++position;
+    return *this;
+}
+
+/**
+ * SparseGrid::const_iterator::operator==(other)
+ *
+ * @return
+ *      True if both iterators are at the same tile.
+ */
+bool SparseGrid::const_iterator::operator==(const const_iterator &other) const
+{
+    return position == other.position;
+}
+
+/**
+ * SparseGrid::const_iterator::operator!=(other)
+ *
+ * @return
+ *      True if the iterators are at different tiles.
+ */
+bool SparseGrid::const_iterator::operator!=(const const_iterator &other) const
+{
+    return position != other.position;
+}
@@ -0,0 +1,94 @@
+/**
+ * Declares a class representing a huge, mostly empty 2d grid of cells stored as sparse tiles.
+ * Rich documentation for the api and behaviour the SparseGrid class can be found in sparse_grid.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <unordered_map>
+#include "grid.h"
+
+/**
+ * Declare the structure of the SparseGrid class, a 2d grid of cells split into 64x64 tiles
+ * where only tiles holding at least one alive cell are stored.
+ */
+class SparseGrid
+{
+public:
+    static const unsigned int TILE_SIZE = 64;
+
+    /**
+     * A 64x64 tile of packed cells, one word per row.
+     * Cell (x, y) of the tile is bit x of rows[y].
+     */
+    struct Tile
+    {
+        int x;
+        int y;
+        unsigned int alive_cells;
+        std::uint64_t rows[TILE_SIZE];
+    };
+
+    /**
+     * Iterates the occupied tiles of a SparseGrid in no particular order.
+     */
+    class const_iterator
+    {
+    private:
+        std::unordered_map<std::uint64_t, Tile>::const_iterator position;
+
+    public:
+        explicit const_iterator(std::unordered_map<std::uint64_t, Tile>::const_iterator position);
+
+        const Tile &operator*() const;
+        const Tile *operator->() const;
+        const_iterator &operator++();
+        bool operator==(const const_iterator &other) const;
+        bool operator!=(const const_iterator &other) const;
+    };
+
+private:
+    unsigned int width;
+    unsigned int height;
+    std::uint64_t alive_cells;
+    std::unordered_map<std::uint64_t, Tile> tiles;
+    static std::uint64_t get_key(const unsigned int tile_x, const unsigned int tile_y);
+    void write_bits(const unsigned int x, const unsigned int y, std::uint64_t bits,
+                    const unsigned int count, const bool alive_only);
+    void write_tile_bits(const unsigned int tile_x, const unsigned int y, const unsigned int shift,
+                         std::uint64_t bits, const unsigned int count, const bool alive_only);
+    void clear(const unsigned int x0, const unsigned int y0, const unsigned int x1, const unsigned int y1);
+
+public:
+    SparseGrid();
+    explicit SparseGrid(const unsigned int square_size);
+    SparseGrid(const unsigned int width, const unsigned int height);
+    explicit SparseGrid(const GridView &view);
+    explicit SparseGrid(const Grid &grid);
+
+    int get_width() const;
+    int get_height() const;
+    std::uint64_t get_total_cells() const;
+    std::uint64_t get_alive_cells() const;
+    std::uint64_t get_dead_cells() const;
+    std::size_t get_tile_count() const;
+
+    Cell get(const int x, const int y) const;
+    void set(const int x, const int y, const Cell value);
+
+    SparseGrid crop(const int x0, const int y0, const int x1, const int y1) const;
+
+    void merge(const GridView &other, const int x0, const int y0, const bool alive_only = false);
+    void merge(const Grid &other, const int x0, const int y0, const bool alive_only = false);
+    void merge(const SparseGrid &other, const int x0, const int y0, const bool alive_only = false);
+
+    Grid to_grid() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+};
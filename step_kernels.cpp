@@ -0,0 +1,773 @@
+/**
+ * Implements a StepKernels namespace with the row kernels that step Life-like rules on packed rows.
+ *      - Every kernel lines up the 8 neighbours of each cell as shifted copies of the rows above, beside,
+ *        and below, sums them with bitwise full adders, and applies the rule as a boolean expression.
+ *          - The scalar kernel does this for one 64 bit word at a time.
+ *          - The AVX2 and AVX-512 kernels do it for 4 and 8 words at a time, the AVX-512 kernel fusing
+ *            each 3 input XOR and majority into a single ternary logic instruction.
+ *          - All kernels give exactly the same words.
+ *
+ *      - Kernels are specialized at compile time for each rule in specialized_rules.
+ *          - B3/S23 has hand tuned kernels that only work out whether the count is 2 or 3.
+ *          - The other rules instantiate templates over their birth and survival masks, which sum the
+ *            count into four bit planes and keep only the terms for the counts the rule uses.
+ *          - Any other rule runs the same templates with the masks read at runtime.
+ *
+ *      - Kernels are picked at runtime from the instruction sets the CPU reports through CPUID,
+ *        so one binary runs the widest kernel each host supports.
+ *          - The vector kernels are compiled with per-function target attributes, so the rest of the
+ *            program needs no extra compiler flags and still runs on CPUs without them.
+ *          - Compilers or CPUs other than GCC or Clang on x86 only get the scalar kernel.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "step_kernels.h"
+#include <stdexcept>
+#include <string>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STEP_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+//the rule helpers must be inlined into each kernel so their masks fold into constants
+#if defined(__GNUC__) || defined(__clang__)
+#define STEP_KERNELS_INLINE inline __attribute__((always_inline))
+#else
+#define STEP_KERNELS_INLINE inline
+#endif
+
+/**
+ * step_word_conway(above, row, below, has_right)
+ *
+ * Helper function to compute the next state of the 64 cells in a word of a row under B3/S23, all at once.
+ * The 8 neighbours of every cell are lined up as shifted copies of the 3 rows, then summed with
+ * bitwise full adders so bit b of each partial sum belongs to cell b, and B3/S23 is applied
+ * as a boolean expression on the sum bits without any per-cell branches.
+ *
+ * @param above
+ *      The word above, its neighbour words are read through above[-1] and above[1].
+ *
+ * @param row
+ *      The word to compute.
+ *
+ * @param below
+ *      The word below.
+ *
+ * @param has_right
+ *      True if the words to the right hold a cell the result depends on.
+ *
+ * @return
+ *      The next state of the 64 cells.
+ */
+static std::uint64_t step_word_conway(const std::uint64_t *above, const std::uint64_t *row,
+                                      const std::uint64_t *below, const bool has_right)
+{
+    //shift each row so bit b holds the cell to the left or right of cell b
+    const std::uint64_t above_left = (above[0] << 1) | (above[-1] >> 63);
+    const std::uint64_t above_right = (above[0] >> 1) | (has_right ? above[1] << 63 : 0);
+    const std::uint64_t left = (row[0] << 1) | (row[-1] >> 63);
+    const std::uint64_t right = (row[0] >> 1) | (has_right ? row[1] << 63 : 0);
+    const std::uint64_t below_left = (below[0] << 1) | (below[-1] >> 63);
+    const std::uint64_t below_right = (below[0] >> 1) | (has_right ? below[1] << 63 : 0);
+
+    //add the 3 cells above, the 2 beside, and the 3 below, each into a ones bit and a twos bit
+    const std::uint64_t above_ones = above_left ^ above[0] ^ above_right;
+    const std::uint64_t above_twos = (above_left & above[0]) | (above_right & (above_left ^ above[0]));
+    const std::uint64_t row_ones = left ^ right;
+    const std::uint64_t row_twos = left & right;
+    const std::uint64_t below_ones = below_left ^ below[0] ^ below_right;
+    const std::uint64_t below_twos = (below_left & below[0]) | (below_right & (below_left ^ below[0]));
+
+    //add the ones, carrying into a fourth twos bit
+    const std::uint64_t ones = above_ones ^ row_ones ^ below_ones;
+    const std::uint64_t carry = (above_ones & row_ones) | (below_ones & (above_ones ^ row_ones));
+
+    //the count is 2 or 3 exactly when one of the four twos bits is set
+    const std::uint64_t twos_odd = above_twos ^ row_twos ^ below_twos ^ carry;
+    const std::uint64_t twos_pair = (above_twos & row_twos) | (below_twos & carry);
+    const std::uint64_t two_or_three = twos_odd & ~twos_pair;
+
+    //3 neighbours is always alive, 2 neighbours only keeps an alive cell alive
+    return two_or_three & (ones | row[0]);
+}
+
+/**
+ * step_row_scalar(above, row, below, next, words, rule)
+ *
+ * Helper function to step a run of words one at a time under B3/S23, the kernel every CPU supports.
+ * Every word must have a readable word to its left and right.
+ */
+static void step_row_scalar(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                            std::uint64_t *next, const std::size_t words, const Rule &)
+{
+    for (std::size_t i = 0; i < words; i++)
+    {
+        next[i] = step_word_conway(above + i, row + i, below + i, true);
+    }
+}
+
+/**
+ * rule_term<N>(ones, twos, fours, eights, alive, birth, survival)
+ *
+ * Helper function to pick out the cells with exactly N alive neighbours from the four bit planes of their
+ * counts, then keep those the rule makes alive. With constant masks a count the rule does not use folds
+ * to 0, and a count used by both birth and survival skips the alive test.
+ * Word is std::uint64_t here, the vector kernels have their own versions.
+ */
+template <unsigned int N>
+static STEP_KERNELS_INLINE std::uint64_t rule_term(const std::uint64_t ones, const std::uint64_t twos,
+                                                   const std::uint64_t fours, const std::uint64_t eights,
+                                                   const std::uint64_t alive, const std::uint16_t birth,
+                                                   const std::uint16_t survival)
+{
+    const bool born = (birth >> N) & 1;
+    const bool kept = (survival >> N) & 1;
+    if (!born && !kept)
+    {
+        return 0;
+    }
+    const std::uint64_t count = ((N & 1) ? ones : ~ones) & ((N & 2) ? twos : ~twos) & ((N & 4) ? fours : ~fours)
+                                & ((N & 8) ? eights : ~eights);
+    return born ? (kept ? count : count & ~alive) : count & alive;
+}
+
+/**
+ * step_word_rule(above, row, below, has_right, birth, survival)
+ *
+ * Helper function to compute the next state of the 64 cells in a word of a row under any Life-like rule.
+ * The neighbours are summed with the same adders as step_word_conway, then the four twos bits are
+ * added on into a fours and an eights plane so every count 0 to 8 can be told apart.
+ *
+ * @param has_right
+ *      True if the words to the right hold a cell the result depends on.
+ *
+ * @param birth
+ *      The birth mask of the rule.
+ *
+ * @param survival
+ *      The survival mask of the rule.
+ *
+ * @return
+ *      The next state of the 64 cells.
+ */
+static STEP_KERNELS_INLINE std::uint64_t step_word_rule(const std::uint64_t *above, const std::uint64_t *row,
+                                                        const std::uint64_t *below, const bool has_right,
+                                                        const std::uint16_t birth, const std::uint16_t survival)
+{
+    const std::uint64_t above_left = (above[0] << 1) | (above[-1] >> 63);
+    const std::uint64_t above_right = (above[0] >> 1) | (has_right ? above[1] << 63 : 0);
+    const std::uint64_t left = (row[0] << 1) | (row[-1] >> 63);
+    const std::uint64_t right = (row[0] >> 1) | (has_right ? row[1] << 63 : 0);
+    const std::uint64_t below_left = (below[0] << 1) | (below[-1] >> 63);
+    const std::uint64_t below_right = (below[0] >> 1) | (has_right ? below[1] << 63 : 0);
+
+    const std::uint64_t above_ones = above_left ^ above[0] ^ above_right;
+    const std::uint64_t above_twos = (above_left & above[0]) | (above_right & (above_left ^ above[0]));
+    const std::uint64_t row_ones = left ^ right;
+    const std::uint64_t row_twos = left & right;
+    const std::uint64_t below_ones = below_left ^ below[0] ^ below_right;
+    const std::uint64_t below_twos = (below_left & below[0]) | (below_right & (below_left ^ below[0]));
+
+    const std::uint64_t ones = above_ones ^ row_ones ^ below_ones;
+    const std::uint64_t carry = (above_ones & row_ones) | (below_ones & (above_ones ^ row_ones));
+
+    //add the four twos bits, the three row sums then the carry
+    const std::uint64_t twos_odd = above_twos ^ row_twos ^ below_twos;
+    const std::uint64_t fours_carry = (above_twos & row_twos) | (below_twos & (above_twos ^ row_twos));
+    const std::uint64_t twos = twos_odd ^ carry;
+    const std::uint64_t twos_carry = twos_odd & carry;
+    const std::uint64_t fours = fours_carry ^ twos_carry;
+    const std::uint64_t eights = fours_carry & twos_carry;
+
+    const std::uint64_t alive = row[0];
+    return rule_term<0>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<1>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<2>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<3>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<4>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<5>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<6>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<7>(ones, twos, fours, eights, alive, birth, survival)
+           | rule_term<8>(ones, twos, fours, eights, alive, birth, survival);
+}
+
+/**
+ * StepKernels::step_word(above, row, below, has_right, rule)
+ *
+ * Compute the next state of the 64 cells in a word of a row, all at once.
+ * B3/S23 runs the hand tuned adders, any other rule the adders of the generic kernels with its masks
+ * read at runtime, which is meant for the odd word at the end of a row rather than whole rows.
+ *
+ * @param above
+ *      The word above, its neighbour words are read through above[-1] and above[1].
+ *
+ * @param row
+ *      The word to compute.
+ *
+ * @param below
+ *      The word below.
+ *
+ * @param has_right
+ *      True if the words to the right hold a cell the result depends on.
+ *
+ * @param rule
+ *      Optional parameter. The rule to step. Defaults to B3/S23.
+ *
+ * @return
+ *      The next state of the 64 cells.
+ */
+std::uint64_t StepKernels::step_word(const std::uint64_t *above, const std::uint64_t *row,
+                                     const std::uint64_t *below, const bool has_right, const Rule &rule)
+{
+    if (rule.is_conway())
+    {
+        return step_word_conway(above, row, below, has_right);
+    }
+    return step_word_rule(above, row, below, has_right, rule.get_birth(), rule.get_survival());
+}
+
+/**
+ * step_row_scalar_rule<Birth, Survival, Generic>(above, row, below, next, words, rule)
+ *
+ * Helper function to step a run of words one at a time under a rule fixed at compile time by its masks,
+ * or with Generic set, under the masks of the rule passed in.
+ * Every word must have a readable word to its left and right.
+ */
+template <std::uint16_t Birth, std::uint16_t Survival, bool Generic>
+static void step_row_scalar_rule(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                                 std::uint64_t *next, const std::size_t words, const Rule &rule)
+{
+    const std::uint16_t birth = Generic ? rule.get_birth() : Birth;
+    const std::uint16_t survival = Generic ? rule.get_survival() : Survival;
+    for (std::size_t i = 0; i < words; i++)
+    {
+        next[i] = step_word_rule(above + i, row + i, below + i, true, birth, survival);
+    }
+}
+
+#ifdef STEP_KERNELS_X86
+
+/**
+ * step_row_avx2(above, row, below, next, words)
+ *
+ * Helper function to step a run of words four at a time with AVX2, then any leftover words one at a time.
+ * The left and right neighbour words are loaded unaligned one word either side of each vector.
+ */
+__attribute__((target("avx2")))
+static void step_row_avx2(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                          std::uint64_t *next, const std::size_t words, const Rule &rule)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= words; i += 4)
+    {
+        const std::uint64_t *rows[3] = {above + i, row + i, below + i};
+        __m256i centre[3];
+        __m256i left[3];
+        __m256i right[3];
+        for (unsigned int r = 0; r < 3; r++)
+        {
+            centre[r] = _mm256_loadu_si256((const __m256i *)rows[r]);
+            left[r] = _mm256_or_si256(_mm256_slli_epi64(centre[r], 1),
+                                      _mm256_srli_epi64(_mm256_loadu_si256((const __m256i *)(rows[r] - 1)), 63));
+            right[r] = _mm256_or_si256(_mm256_srli_epi64(centre[r], 1),
+                                       _mm256_slli_epi64(_mm256_loadu_si256((const __m256i *)(rows[r] + 1)), 63));
+        }
+
+        //the same adder tree as step_word, four words per instruction
+        const __m256i above_ones = _mm256_xor_si256(_mm256_xor_si256(left[0], centre[0]), right[0]);
+        const __m256i above_twos = _mm256_or_si256(_mm256_and_si256(left[0], centre[0]),
+                                                   _mm256_and_si256(right[0], _mm256_xor_si256(left[0], centre[0])));
+        const __m256i row_ones = _mm256_xor_si256(left[1], right[1]);
+        const __m256i row_twos = _mm256_and_si256(left[1], right[1]);
+        const __m256i below_ones = _mm256_xor_si256(_mm256_xor_si256(left[2], centre[2]), right[2]);
+        const __m256i below_twos = _mm256_or_si256(_mm256_and_si256(left[2], centre[2]),
+                                                   _mm256_and_si256(right[2], _mm256_xor_si256(left[2], centre[2])));
+
+        const __m256i ones = _mm256_xor_si256(_mm256_xor_si256(above_ones, row_ones), below_ones);
+        const __m256i carry = _mm256_or_si256(_mm256_and_si256(above_ones, row_ones),
+                                              _mm256_and_si256(below_ones, _mm256_xor_si256(above_ones, row_ones)));
+
+        const __m256i twos_odd = _mm256_xor_si256(_mm256_xor_si256(above_twos, row_twos),
+                                                  _mm256_xor_si256(below_twos, carry));
+        const __m256i twos_pair = _mm256_or_si256(_mm256_and_si256(above_twos, row_twos),
+                                                  _mm256_and_si256(below_twos, carry));
+        //andnot computes ~a & b
+        const __m256i two_or_three = _mm256_andnot_si256(twos_pair, twos_odd);
+        _mm256_storeu_si256((__m256i *)(next + i),
+                            _mm256_and_si256(two_or_three, _mm256_or_si256(ones, centre[1])));
+    }
+    step_row_scalar(above + i, row + i, below + i, next + i, words - i, rule);
+}
+
+/**
+ * rule_term_avx2<N>(ones, twos, fours, eights, alive, birth, survival)
+ *
+ * Helper function to pick out the cells with exactly N alive neighbours that the rule makes alive,
+ * as rule_term does, four words at a time.
+ */
+template <unsigned int N>
+__attribute__((target("avx2")))
+static STEP_KERNELS_INLINE __m256i rule_term_avx2(const __m256i ones, const __m256i twos, const __m256i fours,
+                                                  const __m256i eights, const __m256i alive,
+                                                  const std::uint16_t birth, const std::uint16_t survival)
+{
+    const bool born = (birth >> N) & 1;
+    const bool kept = (survival >> N) & 1;
+    if (!born && !kept)
+    {
+        return _mm256_setzero_si256();
+    }
+    //start from the planes that must be set, then clear the cells where one that must be clear is set
+    const __m256i set = _mm256_set1_epi64x(-1);
+    const __m256i low = _mm256_and_si256(_mm256_and_si256((N & 1) ? ones : set, (N & 2) ? twos : set),
+                                         _mm256_and_si256((N & 4) ? fours : set, (N & 8) ? eights : set));
+    const __m256i clear = _mm256_or_si256(_mm256_or_si256((N & 1) ? _mm256_setzero_si256() : ones,
+                                                          (N & 2) ? _mm256_setzero_si256() : twos),
+                                          _mm256_or_si256((N & 4) ? _mm256_setzero_si256() : fours,
+                                                          (N & 8) ? _mm256_setzero_si256() : eights));
+    const __m256i count = _mm256_andnot_si256(clear, low);
+    return born ? (kept ? count : _mm256_andnot_si256(alive, count)) : _mm256_and_si256(count, alive);
+}
+
+/**
+ * step_row_avx2_rule<Birth, Survival, Generic>(above, row, below, next, words, rule)
+ *
+ * Helper function to step a run of words four at a time with AVX2 under a rule fixed at compile time,
+ * or with Generic set under the rule passed in, then any leftover words one at a time.
+ */
+template <std::uint16_t Birth, std::uint16_t Survival, bool Generic>
+__attribute__((target("avx2")))
+static void step_row_avx2_rule(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                               std::uint64_t *next, const std::size_t words, const Rule &rule)
+{
+    const std::uint16_t birth = Generic ? rule.get_birth() : Birth;
+    const std::uint16_t survival = Generic ? rule.get_survival() : Survival;
+    std::size_t i = 0;
+    for (; i + 4 <= words; i += 4)
+    {
+        const std::uint64_t *rows[3] = {above + i, row + i, below + i};
+        __m256i centre[3];
+        __m256i left[3];
+        __m256i right[3];
+        for (unsigned int r = 0; r < 3; r++)
+        {
+            centre[r] = _mm256_loadu_si256((const __m256i *)rows[r]);
+            left[r] = _mm256_or_si256(_mm256_slli_epi64(centre[r], 1),
+                                      _mm256_srli_epi64(_mm256_loadu_si256((const __m256i *)(rows[r] - 1)), 63));
+            right[r] = _mm256_or_si256(_mm256_srli_epi64(centre[r], 1),
+                                       _mm256_slli_epi64(_mm256_loadu_si256((const __m256i *)(rows[r] + 1)), 63));
+        }
+
+        const __m256i above_ones = _mm256_xor_si256(_mm256_xor_si256(left[0], centre[0]), right[0]);
+        const __m256i above_twos = _mm256_or_si256(_mm256_and_si256(left[0], centre[0]),
+                                                   _mm256_and_si256(right[0], _mm256_xor_si256(left[0], centre[0])));
+        const __m256i row_ones = _mm256_xor_si256(left[1], right[1]);
+        const __m256i row_twos = _mm256_and_si256(left[1], right[1]);
+        const __m256i below_ones = _mm256_xor_si256(_mm256_xor_si256(left[2], centre[2]), right[2]);
+        const __m256i below_twos = _mm256_or_si256(_mm256_and_si256(left[2], centre[2]),
+                                                   _mm256_and_si256(right[2], _mm256_xor_si256(left[2], centre[2])));
+
+        const __m256i ones = _mm256_xor_si256(_mm256_xor_si256(above_ones, row_ones), below_ones);
+        const __m256i carry = _mm256_or_si256(_mm256_and_si256(above_ones, row_ones),
+                                              _mm256_and_si256(below_ones, _mm256_xor_si256(above_ones, row_ones)));
+
+        //the same four bit planes as step_word_rule
+        const __m256i twos_odd = _mm256_xor_si256(_mm256_xor_si256(above_twos, row_twos), below_twos);
+        const __m256i fours_carry = _mm256_or_si256(_mm256_and_si256(above_twos, row_twos),
+                                                    _mm256_and_si256(below_twos, _mm256_xor_si256(above_twos, row_twos)));
+        const __m256i twos = _mm256_xor_si256(twos_odd, carry);
+        const __m256i twos_carry = _mm256_and_si256(twos_odd, carry);
+        const __m256i fours = _mm256_xor_si256(fours_carry, twos_carry);
+        const __m256i eights = _mm256_and_si256(fours_carry, twos_carry);
+
+        const __m256i alive = centre[1];
+        __m256i result = rule_term_avx2<0>(ones, twos, fours, eights, alive, birth, survival);
+        result = _mm256_or_si256(result, rule_term_avx2<1>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<2>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<3>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<4>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<5>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<6>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<7>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm256_or_si256(result, rule_term_avx2<8>(ones, twos, fours, eights, alive, birth, survival));
+        _mm256_storeu_si256((__m256i *)(next + i), result);
+    }
+    step_row_scalar_rule<Birth, Survival, Generic>(above + i, row + i, below + i, next + i, words - i, rule);
+}
+
+/**
+ * step_row_avx512(above, row, below, next, words)
+ *
+ * Helper function to step a run of words eight at a time with AVX-512, then any leftover words one at a time.
+ * Each 3 input XOR (truth table 0x96), majority (truth table 0xE8), and the final rule is a single
+ * ternary logic instruction.
+ */
+__attribute__((target("avx512f")))
+static void step_row_avx512(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                            std::uint64_t *next, const std::size_t words, const Rule &rule)
+{
+    //the zero masked shifts are the plain shifts with every lane kept, written this way because
+    //some compilers warn about the undefined pass-through lanes of the unmasked forms
+    const __mmask8 all = 0xFF;
+    std::size_t i = 0;
+    for (; i + 8 <= words; i += 8)
+    {
+        const std::uint64_t *rows[3] = {above + i, row + i, below + i};
+        __m512i centre[3];
+        __m512i left[3];
+        __m512i right[3];
+        for (unsigned int r = 0; r < 3; r++)
+        {
+            centre[r] = _mm512_loadu_si512((const void *)rows[r]);
+            left[r] = _mm512_or_si512(_mm512_maskz_slli_epi64(all, centre[r], 1),
+                                      _mm512_maskz_srli_epi64(all, _mm512_loadu_si512((const void *)(rows[r] - 1)), 63));
+            right[r] = _mm512_or_si512(_mm512_maskz_srli_epi64(all, centre[r], 1),
+                                       _mm512_maskz_slli_epi64(all, _mm512_loadu_si512((const void *)(rows[r] + 1)), 63));
+        }
+
+        const __m512i above_ones = _mm512_ternarylogic_epi64(left[0], centre[0], right[0], 0x96);
+        const __m512i above_twos = _mm512_ternarylogic_epi64(left[0], centre[0], right[0], 0xE8);
+        const __m512i row_ones = _mm512_xor_si512(left[1], right[1]);
+        const __m512i row_twos = _mm512_and_si512(left[1], right[1]);
+        const __m512i below_ones = _mm512_ternarylogic_epi64(left[2], centre[2], right[2], 0x96);
+        const __m512i below_twos = _mm512_ternarylogic_epi64(left[2], centre[2], right[2], 0xE8);
+
+        const __m512i ones = _mm512_ternarylogic_epi64(above_ones, row_ones, below_ones, 0x96);
+        const __m512i carry = _mm512_ternarylogic_epi64(above_ones, row_ones, below_ones, 0xE8);
+
+        const __m512i twos_odd = _mm512_xor_si512(_mm512_ternarylogic_epi64(above_twos, row_twos, below_twos, 0x96),
+                                                  carry);
+        const __m512i twos_pair = _mm512_or_si512(_mm512_and_si512(above_twos, row_twos),
+                                                  _mm512_and_si512(below_twos, carry));
+        //twos_odd & ~twos_pair & (ones | centre) is truth table 0x20
+        const __m512i survive_or_birth = _mm512_or_si512(ones, centre[1]);
+        _mm512_storeu_si512((void *)(next + i), _mm512_ternarylogic_epi64(twos_odd, twos_pair, survive_or_birth, 0x20));
+    }
+    step_row_scalar(above + i, row + i, below + i, next + i, words - i, rule);
+}
+
+/**
+ * rule_term_avx512<N>(ones, twos, fours, eights, alive, birth, survival)
+ *
+ * Helper function to pick out the cells with exactly N alive neighbours that the rule makes alive,
+ * as rule_term does, eight words at a time. Matching the low three planes against N is one ternary
+ * logic instruction, whose truth table is 1 only at index N & 7.
+ */
+template <unsigned int N>
+__attribute__((target("avx512f")))
+static STEP_KERNELS_INLINE __m512i rule_term_avx512(const __m512i ones, const __m512i twos, const __m512i fours,
+                                                    const __m512i eights, const __m512i alive,
+                                                    const std::uint16_t birth, const std::uint16_t survival)
+{
+    const bool born = (birth >> N) & 1;
+    const bool kept = (survival >> N) & 1;
+    if (!born && !kept)
+    {
+        return _mm512_setzero_si512();
+    }
+    //zero masked like the shifts of step_row_avx512, the unmasked andnot warns about its pass-through lanes
+    const __mmask8 all = 0xFF;
+    const __m512i low = _mm512_ternarylogic_epi64(fours, twos, ones, 1 << (N & 7));
+    const __m512i count = (N & 8) ? _mm512_and_si512(low, eights) : _mm512_maskz_andnot_epi64(all, eights, low);
+    return born ? (kept ? count : _mm512_maskz_andnot_epi64(all, alive, count)) : _mm512_and_si512(count, alive);
+}
+
+/**
+ * step_row_avx512_rule<Birth, Survival, Generic>(above, row, below, next, words, rule)
+ *
+ * Helper function to step a run of words eight at a time with AVX-512 under a rule fixed at compile time,
+ * or with Generic set under the rule passed in, then any leftover words one at a time.
+ */
+template <std::uint16_t Birth, std::uint16_t Survival, bool Generic>
+__attribute__((target("avx512f")))
+static void step_row_avx512_rule(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                                 std::uint64_t *next, const std::size_t words, const Rule &rule)
+{
+    const std::uint16_t birth = Generic ? rule.get_birth() : Birth;
+    const std::uint16_t survival = Generic ? rule.get_survival() : Survival;
+    const __mmask8 all = 0xFF;
+    std::size_t i = 0;
+    for (; i + 8 <= words; i += 8)
+    {
+        const std::uint64_t *rows[3] = {above + i, row + i, below + i};
+        __m512i centre[3];
+        __m512i left[3];
+        __m512i right[3];
+        for (unsigned int r = 0; r < 3; r++)
+        {
+            centre[r] = _mm512_loadu_si512((const void *)rows[r]);
+            left[r] = _mm512_or_si512(_mm512_maskz_slli_epi64(all, centre[r], 1),
+                                      _mm512_maskz_srli_epi64(all, _mm512_loadu_si512((const void *)(rows[r] - 1)), 63));
+            right[r] = _mm512_or_si512(_mm512_maskz_srli_epi64(all, centre[r], 1),
+                                       _mm512_maskz_slli_epi64(all, _mm512_loadu_si512((const void *)(rows[r] + 1)), 63));
+        }
+
+        const __m512i above_ones = _mm512_ternarylogic_epi64(left[0], centre[0], right[0], 0x96);
+        const __m512i above_twos = _mm512_ternarylogic_epi64(left[0], centre[0], right[0], 0xE8);
+        const __m512i row_ones = _mm512_xor_si512(left[1], right[1]);
+        const __m512i row_twos = _mm512_and_si512(left[1], right[1]);
+        const __m512i below_ones = _mm512_ternarylogic_epi64(left[2], centre[2], right[2], 0x96);
+        const __m512i below_twos = _mm512_ternarylogic_epi64(left[2], centre[2], right[2], 0xE8);
+
+        const __m512i ones = _mm512_ternarylogic_epi64(above_ones, row_ones, below_ones, 0x96);
+        const __m512i carry = _mm512_ternarylogic_epi64(above_ones, row_ones, below_ones, 0xE8);
+
+        //the same four bit planes as step_word_rule
+        const __m512i twos_odd = _mm512_ternarylogic_epi64(above_twos, row_twos, below_twos, 0x96);
+        const __m512i fours_carry = _mm512_ternarylogic_epi64(above_twos, row_twos, below_twos, 0xE8);
+        const __m512i twos = _mm512_xor_si512(twos_odd, carry);
+        const __m512i twos_carry = _mm512_and_si512(twos_odd, carry);
+        const __m512i fours = _mm512_xor_si512(fours_carry, twos_carry);
+        const __m512i eights = _mm512_and_si512(fours_carry, twos_carry);
+
+        const __m512i alive = centre[1];
+        __m512i result = rule_term_avx512<0>(ones, twos, fours, eights, alive, birth, survival);
+        result = _mm512_or_si512(result, rule_term_avx512<1>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<2>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<3>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<4>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<5>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<6>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<7>(ones, twos, fours, eights, alive, birth, survival));
+        result = _mm512_or_si512(result, rule_term_avx512<8>(ones, twos, fours, eights, alive, birth, survival));
+        _mm512_storeu_si512((void *)(next + i), result);
+    }
+    step_row_scalar_rule<Birth, Survival, Generic>(above + i, row + i, below + i, next + i, words - i, rule);
+}
+
+#endif
+
+/**
+ * get_mask(digits)
+ *
+ * Helper function to turn a list of neighbour counts into a rule mask at compile time.
+ */
+static constexpr std::uint16_t get_mask(const char *digits)
+{
+    return *digits ? std::uint16_t((1 << (*digits - '0')) | get_mask(digits + 1)) : 0;
+}
+
+/**
+ * get_rule_kernel<Birth, Survival, Generic>(kernel)
+ *
+ * Helper function to get the row function of one kernel for a rule fixed at compile time,
+ * or with Generic set for the rule passed to it. The kernel must be supported.
+ */
+template <std::uint16_t Birth, std::uint16_t Survival, bool Generic>
+static StepKernels::RowKernel get_rule_kernel(const Kernel kernel)
+{
+#ifdef STEP_KERNELS_X86
+    if (kernel == Kernel::AVX512)
+    {
+        return step_row_avx512_rule<Birth, Survival, Generic>;
+    }
+    else if (kernel == Kernel::AVX2)
+    {
+        return step_row_avx2_rule<Birth, Survival, Generic>;
+    }
+#endif
+    return step_row_scalar_rule<Birth, Survival, Generic>;
+}
+
+/**
+ * A SpecializedRule is a rule with kernels compiled for its masks, found by get_kernel.
+ */
+struct SpecializedRule
+{
+    std::uint16_t birth;
+    std::uint16_t survival;
+    StepKernels::RowKernel (*get_kernel)(const Kernel kernel);
+};
+
+/**
+ * specialized_rules
+ *
+ * The rules other than B3/S23 that get their own kernels, the popular Life-like rules from
+ * https://conwaylife.com/wiki/List_of_Life-like_rules. Others run the generic kernels.
+ */
+static const SpecializedRule specialized_rules[] = {
+    //HighLife
+    {get_mask("36"), get_mask("23"), get_rule_kernel<get_mask("36"), get_mask("23"), false>},
+    //Day & Night
+    {get_mask("3678"), get_mask("34678"), get_rule_kernel<get_mask("3678"), get_mask("34678"), false>},
+    //Seeds
+    {get_mask("2"), get_mask(""), get_rule_kernel<get_mask("2"), get_mask(""), false>},
+    //Life without Death
+    {get_mask("3"), get_mask("012345678"), get_rule_kernel<get_mask("3"), get_mask("012345678"), false>},
+    //Replicator
+    {get_mask("1357"), get_mask("1357"), get_rule_kernel<get_mask("1357"), get_mask("1357"), false>},
+    //2x2
+    {get_mask("36"), get_mask("125"), get_rule_kernel<get_mask("36"), get_mask("125"), false>},
+    //Morley
+    {get_mask("368"), get_mask("245"), get_rule_kernel<get_mask("368"), get_mask("245"), false>},
+    //Anneal
+    {get_mask("4678"), get_mask("35678"), get_rule_kernel<get_mask("4678"), get_mask("35678"), false>},
+    //Diamoeba
+    {get_mask("35678"), get_mask("5678"), get_rule_kernel<get_mask("35678"), get_mask("5678"), false>},
+};
+
+/**
+ * find_specialized(rule)
+ *
+ * Helper function to find the entry of specialized_rules for a rule.
+ *
+ * @return
+ *      The entry, or nullptr if the rule has no kernels of its own.
+ */
+static const SpecializedRule *find_specialized(const Rule &rule)
+{
+    for (const SpecializedRule &specialized : specialized_rules)
+    {
+        if (specialized.birth == rule.get_birth() && specialized.survival == rule.get_survival())
+        {
+            return &specialized;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * StepKernels::is_supported(kernel)
+ *
+ * Check whether this build and the CPU it is running on can run a kernel, using CPUID.
+ * The checks include the operating system saving the wider vector registers.
+ *
+ * @param kernel
+ *      The kernel to check.
+ *
+ * @return
+ *      True if the kernel can run on this host.
+ */
+bool StepKernels::is_supported(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::SCALAR:
+        return true;
+#ifdef STEP_KERNELS_X86
+    case Kernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case Kernel::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * StepKernels::get_widest()
+ *
+ * Gets the widest kernel this host supports. CPUID is only queried the first time.
+ *
+ * @example
+ *
+ *      // Report the kernel World uses for StepEngine::VECTOR
+ *      std::cout << StepKernels::get_name(StepKernels::get_widest()) << std::endl;
+ *
+ * @return
+ *      Kernel::AVX512 if supported, otherwise Kernel::AVX2 if supported, otherwise Kernel::SCALAR.
+ */
+Kernel StepKernels::get_widest()
+{
+    static const Kernel widest = is_supported(Kernel::AVX512) ? Kernel::AVX512
+                                 : is_supported(Kernel::AVX2) ? Kernel::AVX2
+                                                              : Kernel::SCALAR;
+    return widest;
+}
+
+/**
+ * StepKernels::is_specialized(rule)
+ *
+ * Check whether a rule has kernels compiled for it, B3/S23 or one of specialized_rules.
+ * Other rules run the generic kernels, which test the masks for each count as they go.
+ *
+ * @param rule
+ *      The rule to check.
+ *
+ * @return
+ *      True if the rule has kernels of its own.
+ */
+bool StepKernels::is_specialized(const Rule &rule)
+{
+    return rule.is_conway() || find_specialized(rule) != nullptr;
+}
+
+/**
+ * StepKernels::get_row_kernel(kernel, rule)
+ *
+ * Gets the function that steps a run of whole words with a kernel under a rule.
+ * The function writes next[i] for i in [0, words) from the words at index i of above, row, and below,
+ * reading one word either side, so every word must have a readable word to its left and right.
+ * The same rule must be passed to the function, only the generic kernels read it.
+ *
+ * @example
+ *
+ *      // Step a padded row under HighLife with the widest kernel
+ *      const Rule highlife("B36/S23");
+ *      StepKernels::get_row_kernel(StepKernels::get_widest(), highlife)(above, row, below, next, words, highlife);
+ *
+ * @param kernel
+ *      The kernel to get.
+ *
+ * @param rule
+ *      Optional parameter. The rule to step. Defaults to B3/S23.
+ *
+ * @return
+ *      The row function of the kernel.
+ *
+ * @throws
+ *      std::invalid_argument if the kernel is not supported on this host.
+ */
+StepKernels::RowKernel StepKernels::get_row_kernel(const Kernel kernel, const Rule &rule)
+{
+    if (!is_supported(kernel))
+    {
+        throw std::invalid_argument(std::string(get_name(kernel)) + " kernel not supported on this host.");
+    }
+    if (!rule.is_conway())
+    {
+        const SpecializedRule *specialized = find_specialized(rule);
+        return specialized ? specialized->get_kernel(kernel) : get_rule_kernel<0, 0, true>(kernel);
+    }
+#ifdef STEP_KERNELS_X86
+    if (kernel == Kernel::AVX512)
+    {
+        return step_row_avx512;
+    }
+    else if (kernel == Kernel::AVX2)
+    {
+        return step_row_avx2;
+    }
+#endif
+    return step_row_scalar;
+}
+
+/**
+ * StepKernels::get_name(kernel)
+ *
+ * Gets the name of a kernel, for reporting which one was chosen.
+ *
+ * @param kernel
+ *      The kernel to name.
+ *
+ * @return
+ *      "scalar", "avx2", or "avx512".
+ */
+const char *StepKernels::get_name(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::AVX2:
+        return "avx2";
+    case Kernel::AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,47 @@
+/**
+ * Declares a StepKernels namespace with the row kernels that step 64 or more cells of a Life-like rule at once.
+ * Rich documentation for the api and behaviour the StepKernels namespace can be found in step_kernels.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <cstddef>
+#include <cstdint>
+#include "rule.h"
+
+/**
+ * A Kernel names one implementation of the bitsliced row step, from narrowest to widest.
+ *      - Kernel::SCALAR steps one 64 bit word at a time and runs everywhere.
+ *      - Kernel::AVX2 steps four words at a time with 256 bit vectors.
+ *      - Kernel::AVX512 steps eight words at a time with 512 bit vectors.
+ */
+enum class Kernel : char
+{
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+/**
+ * Declare the interface of the StepKernels namespace for stepping packed rows and picking a kernel at runtime.
+ */
+namespace StepKernels
+{
+
+typedef void (*RowKernel)(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                          std::uint64_t *next, const std::size_t words, const Rule &rule);
+
+std::uint64_t step_word(const std::uint64_t *above, const std::uint64_t *row, const std::uint64_t *below,
+                        const bool has_right, const Rule &rule = Rule());
+
+bool is_supported(const Kernel kernel);
+bool is_specialized(const Rule &rule);
+Kernel get_widest();
+RowKernel get_row_kernel(const Kernel kernel, const Rule &rule = Rule());
+const char *get_name(const Kernel kernel);
+
+}; // namespace StepKernels
@@ -0,0 +1,353 @@
+/**
+ * Implements a pool of persistent worker threads for running a batch of tasks in parallel.
+ *      - The worker threads are started once when the pool is made and joined when it is destroyed,
+ *        so running a batch never creates a thread.
+ *          - A pool of N threads starts N - 1 workers, the thread calling ThreadPool::run is thread 0.
+ *
+ *      - A batch is a number of tasks and a function taking the task index and the thread running it.
+ *          - The tasks are dealt out in contiguous runs, one run to the deque of each thread.
+ *          - Threads take their own tasks from the front of their deque, in order. A thread whose deque
+ *            is empty steals from the back of the others, so a thread stuck with expensive tasks has
+ *            the rest of its run taken over by idle threads.
+ *          - ThreadPool::run returns once every task has finished, which acts as a barrier
+ *            between one batch and the next.
+ *          - The first exception thrown by a task is rethrown from ThreadPool::run after the batch.
+ *
+ *      - Each thread counts the tasks it ran, how many it stole, and the time it spent running them
+ *        against the time of the batches, to see how evenly the work was spread.
+ *
+ *      - Batches from different threads sharing a pool are run one after the other.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "thread_pool.h"
+#include <chrono>
+#include <stdexcept>
+
+/**
+ * get_time_ns()
+ *
+ * Helper function to read a steady clock in nanoseconds, for timing tasks and batches.
+ */
+static std::uint64_t get_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * ThreadPool::ThreadPool(threads)
+ *
+ * Construct a pool that runs batches on a number of threads, starting all but one of them as workers.
+ *
+ * @example
+ *
+ *      // Run on every hardware thread
+ *      ThreadPool pool(ThreadPool::get_hardware_threads());
+ *
+ * @param threads
+ *      The number of threads that run each batch, including the calling thread.
+ *
+ * @throws
+ *      std::invalid_argument if the number of threads is 0.
+ */
+ThreadPool::ThreadPool(const unsigned int threads)
+    : work(nullptr), failed(false), batch(0), busy_workers(0), stopping(false)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("thread pool needs at least 1 thread.");
+    }
+    queues.reset(new WorkQueue[threads]);
+    workers.reserve(threads - 1);
+    for (unsigned int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(&ThreadPool::work_loop, this, i);
+    }
+}
+
+/**
+ * ThreadPool::~ThreadPool()
+ *
+ * Wake every worker to stop, then wait for them to finish.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * ThreadPool::get_threads()
+ *
+ * Gets the number of threads that run each batch, including the calling thread.
+ *
+ * @return
+ *      The number of threads.
+ */
+unsigned int ThreadPool::get_threads() const
+{
+    return workers.size() + 1;
+}
+
+/**
+ * ThreadPool::run(tasks, work)
+ *
+ * Run work(task, thread) for every task index in [0, tasks) across the threads of the pool and wait for all of them.
+ * Tasks may run in any order and on any thread, so they must only write memory no other task touches.
+ * The thread index is in [0, get_threads()) and no two tasks run on the same thread at once,
+ * so it can pick scratch space owned by that thread.
+ *
+ * Task i starts on the deque of thread i * threads / tasks, so neighbouring tasks begin on the same
+ * thread and only move when another thread runs out of work.
+ *
+ * @example
+ *
+ *      // Sum each row of a table in parallel
+ *      ThreadPool pool(4);
+ *      pool.run(rows, [&](unsigned int row, unsigned int thread) { sums[row] = sum(table[row]); });
+ *
+ * @param tasks
+ *      The number of tasks.
+ *
+ * @param work
+ *      The function to run for each task index.
+ *
+ * @throws
+ *      The first exception thrown by a task, once every other task has finished or been skipped.
+ */
+void ThreadPool::run(const unsigned int tasks, const Work &work)
+{
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    const unsigned int threads = get_threads();
+    const std::uint64_t start = get_time_ns();
+    //a single task, or a pool without workers, is not worth waking anyone for
+    if (workers.empty() || tasks <= 1)
+    {
+        for (unsigned int i = 0; i < tasks; i++)
+        {
+            const std::uint64_t task_start = get_time_ns();
+            work(i, 0);
+            queues[0].stats.tasks++;
+            queues[0].stats.busy_ns += get_time_ns() - task_start;
+        }
+        queues[0].stats.batch_ns += get_time_ns() - start;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        for (unsigned int t = 0; t < threads; t++)
+        {
+            queues[t].tasks.clear();
+            for (unsigned int i = std::uint64_t(tasks) * t / threads; i < std::uint64_t(tasks) * (t + 1) / threads; i++)
+            {
+                queues[t].tasks.push_back(i);
+            }
+        }
+        this->work = &work;
+        failed = false;
+        error = nullptr;
+        busy_workers = workers.size();
+        batch++;
+    }
+    work_ready.notify_all();
+    run_tasks(0);
+
+    //wait for the workers to finish their last tasks
+    std::unique_lock<std::mutex> lock(state_mutex);
+    work_done.wait(lock, [this] { return busy_workers == 0; });
+    this->work = nullptr;
+    const std::uint64_t batch_ns = get_time_ns() - start;
+    for (unsigned int t = 0; t < threads; t++)
+    {
+        queues[t].stats.batch_ns += batch_ns;
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * ThreadPool::get_stats()
+ *
+ * Gets the work counts of every thread since the pool was made or ThreadPool::reset_stats was called.
+ * Waits for any batch being run by another thread to finish first.
+ *
+ * @example
+ *
+ *      // Print how busy each thread was
+ *      for (const ThreadStats &stats : pool.get_stats())
+ *      {
+ *          std::cout << 100.0 * stats.busy_ns / stats.batch_ns << "%" << std::endl;
+ *      }
+ *
+ * @return
+ *      The stats of each thread, index 0 being the thread that calls ThreadPool::run.
+ */
+std::vector<ThreadStats> ThreadPool::get_stats()
+{
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    std::vector<ThreadStats> stats(get_threads());
+    for (unsigned int t = 0; t < stats.size(); t++)
+    {
+        stats[t] = queues[t].stats;
+    }
+    return stats;
+}
+
+/**
+ * ThreadPool::reset_stats()
+ *
+ * Sets the work counts of every thread back to 0.
+ */
+void ThreadPool::reset_stats()
+{
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    for (unsigned int t = 0; t < get_threads(); t++)
+    {
+        queues[t].stats = ThreadStats{};
+    }
+}
+
+/**
+ * ThreadPool::take_task(thread, task, stolen)
+ *
+ * Private helper function to take the next task for a thread, from the front of its own deque,
+ * or failing that from the back of the next thread along with any left.
+ * No tasks are added during a batch, so once every deque is empty the thread is done.
+ *
+ * @param thread
+ *      The thread taking a task.
+ *
+ * @param task
+ *      Set to the task taken.
+ *
+ * @param stolen
+ *      Set to true if the task came from another thread's deque.
+ *
+ * @return
+ *      False if there are no tasks left.
+ */
+bool ThreadPool::take_task(const unsigned int thread, unsigned int &task, bool &stolen)
+{
+    const unsigned int threads = get_threads();
+    for (unsigned int i = 0; i < threads; i++)
+    {
+        WorkQueue &queue = queues[(thread + i) % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+        //the owner works forwards through its run while thieves take from the far end
+        stolen = (i != 0);
+        if (stolen)
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * ThreadPool::run_tasks(thread)
+ *
+ * Private helper function to take and run tasks of the current batch on a thread until none are left.
+ * After an exception the remaining tasks are skipped.
+ *
+ * @param thread
+ *      The thread running the tasks.
+ */
+void ThreadPool::run_tasks(const unsigned int thread)
+{
+    ThreadStats &stats = queues[thread].stats;
+    unsigned int task = 0;
+    bool stolen = false;
+    while (!failed && take_task(thread, task, stolen))
+    {
+        const std::uint64_t start = get_time_ns();
+        try
+        {
+            (*work)(task, thread);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+        stats.tasks++;
+        stats.stolen += stolen;
+        stats.busy_ns += get_time_ns() - start;
+    }
+}
+
+/**
+ * ThreadPool::work_loop(thread)
+ *
+ * Private helper function run by each worker, sleeping until a new batch starts or the pool stops.
+ *
+ * @param thread
+ *      The index of the worker's thread, from 1.
+ */
+void ThreadPool::work_loop(const unsigned int thread)
+{
+    unsigned long long seen = 0;
+    std::unique_lock<std::mutex> lock(state_mutex);
+    while (true)
+    {
+        work_ready.wait(lock, [this, seen] { return stopping || batch != seen; });
+        if (stopping)
+        {
+            return;
+        }
+        seen = batch;
+
+        lock.unlock();
+        run_tasks(thread);
+        lock.lock();
+
+        //the last worker to finish releases the thread waiting in run
+        if (--busy_workers == 0)
+        {
+            work_done.notify_one();
+        }
+    }
+}
+
+/**
+ * ThreadPool::get_hardware_threads()
+ *
+ * Gets the number of threads the hardware can run at once, for sizing a pool.
+ *
+ * @return
+ *      The number of hardware threads, or 1 if it cannot be found.
+ */
+unsigned int ThreadPool::get_hardware_threads()
+{
+    const unsigned int threads = std::thread::hardware_concurrency();
+    return (threads == 0) ? 1 : threads;
+}
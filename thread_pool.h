@@ -0,0 +1,86 @@
+/**
+ * Declares a pool of persistent worker threads for running a batch of tasks in parallel.
+ * Rich documentation for the api and behaviour the ThreadPool class can be found in thread_pool.cpp.
+ *
+ * @author 954519
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadStats counts the work one thread of a ThreadPool has done since its stats were last reset.
+ *      - tasks is the number of tasks the thread ran, stolen of them taken from other threads' queues.
+ *      - busy_ns is the time spent running tasks, and batch_ns the time of the batches it took part in,
+ *        so busy_ns / batch_ns is how much of each batch the thread was working.
+ */
+struct ThreadStats
+{
+    std::uint64_t tasks;
+    std::uint64_t stolen;
+    std::uint64_t busy_ns;
+    std::uint64_t batch_ns;
+};
+
+/**
+ * Declare the structure of the ThreadPool class, which starts its workers once and wakes them
+ * for each batch of tasks, with the calling thread working alongside them until the batch is done.
+ * Each thread has its own deque of tasks, and steals from the others once its own runs dry.
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void(unsigned int task, unsigned int thread)> Work;
+
+private:
+    //the tasks of one thread and the counts of what it ran, locked only when taking a task
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<unsigned int> tasks;
+        ThreadStats stats = ThreadStats();
+    };
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<WorkQueue[]> queues;
+    std::mutex run_mutex;
+    std::mutex state_mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const Work *work;
+    std::atomic<bool> failed;
+    unsigned long long batch;
+    unsigned int busy_workers;
+    bool stopping;
+    std::exception_ptr error;
+
+    bool take_task(const unsigned int thread, unsigned int &task, bool &stolen);
+    void run_tasks(const unsigned int thread);
+    void work_loop(const unsigned int thread);
+
+public:
+    explicit ThreadPool(const unsigned int threads);
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+    ~ThreadPool();
+
+    unsigned int get_threads() const;
+    void run(const unsigned int tasks, const Work &work);
+
+    std::vector<ThreadStats> get_stats();
+    void reset_stats();
+
+    static unsigned int get_hardware_threads();
+};
@@ -10,14 +10,44 @@
  *
  *      - Stepping a world forward in time applies the rules of Conway's Game of Life.
  *          - https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
+ *          - Or any other Life-like rule given in B/S notation, see Rule.
  *
  *      - Worlds have a private helper function used to count the number of alive cells in a 3x3 neighbours
  *        around a given cell.
+ *      - Worlds can instead step with a lookup table engine, which reads the 4x4 neighbourhood of each
+ *        2x2 block of cells as a 16 bit index into a precomputed table of the block's next state.
+ *          - The table is built for the World's rule, so any rule costs the same.
+ *      - Or with a bitsliced engine, which steps 64 cells per word with shifted rows and full adders.
+ *          - The vector engine runs the same adders on 4 or 8 words at a time with the widest AVX2 or
+ *            AVX-512 kernel the CPU reports, see StepKernels.
+ *          - Common rules have kernels compiled for their masks, other rules run generic kernels.
+ *          - Both grids have a 1 cell halo, refreshed with dead or wrapped cells before each step,
+ *            so the neighbourhood can be read without any edge handling.
+ *
+ *      - Worlds split the grid into tiles and track which tiles changed in the last generation.
+ *          - Only tiles that changed, or are next to one that did, are computed. The rest are left in the
+ *            next state grid, which still holds the same cells from the generation before.
+ *
+ *      - Worlds can step on several threads, running the active tiles on a persistent ThreadPool,
+ *        where idle threads steal tiles from busy ones.
+ *          - Each run of tiles writes only its own words of the next state grid and collects the changes
+ *            to the counts in its own GridDelta, merged once every run is done, so results match one thread.
+ *
+ *      - Advancing a large, busy world by several generations with a bitsliced engine is temporally blocked.
+ *          - The rows are split into bands, and each band is copied into a small scratch buffer with enough
+ *            rows around it to compute several generations there before the result is written back,
+ *            so the cells cross main memory once per block of generations instead of once per generation.
  *
  *      - Updating the world state can conditionally be performed using a toroidal topology.
  *          - Moving off the left edge you appear on the right edge and vice versa.
  *          - Moving off the top edge you appear on the bottom edge and vice versa.
  *
+ *      - Or the world can be an unbounded plane, which grows before a step whenever alive cells come
+ *        close enough to an edge to reach past it.
+ *          - The world grows by half its size or more on the sides that need it, so growing is amortized.
+ *          - The origin gives the plane coordinates of cell 0,0, which move as the world grows left and up.
+ *          - Growth stops at a memory cap, past which the edges behave as in the bounded world.
+ *
  * @author 954519
  * @date March, 2020
  */
@@ -25,8 +55,17 @@
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
 #include "world.h"
+#include "arena.h"
 #include "grid.h"
+#include "bits.h"
+#include "step_kernels.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 /**
  * World::World()
  *
@@ -83,10 +122,11 @@ World::World(const unsigned int square_size) : World(square_size, square_size)
  *      The height of the world.
  */
 World::World(const unsigned int width, const unsigned int height)
+    : current_grid(width, height, 1), next_grid(width, height, 1), engine(StepEngine::COUNT),
+      kernel(StepKernels::get_widest()), rule(), threads(1), tiles_valid(false), tiles_toroidal(false), unbounded(false),
+      capped(false), memory_cap(std::size_t(1) << 30), origin_x(0), origin_y(0)
 {
-    //resize to make all cells dead
-    current_grid.resize(width, height);
-    next_grid.resize(width, height);
+    //all cells start dead, with a 1 cell halo for count_neighbours
 }
 
 World::~World()
@@ -113,9 +153,10 @@ World::~World()
  *      The state of the constructed world.
  */
 World::World(Grid initial_state)
+    : World(initial_state.get_width(), initial_state.get_height())
 {
-    current_grid = initial_state;
-    next_grid = initial_state;
+    //copy the state into the halo padded grid
+    current_grid.merge(initial_state, 0, 0);
 }
 
 /**
@@ -197,7 +238,7 @@ int World::get_height() const
  * @return
  *      The number of total cells.
  */
-unsigned int World::get_total_cells() const
+std::uint64_t World::get_total_cells() const
 {
     return current_grid.get_total_cells();
 }
@@ -225,7 +266,7 @@ unsigned int World::get_total_cells() const
  * @return
  *      The number of alive cells.
  */
-unsigned int World::get_alive_cells() const
+std::uint64_t World::get_alive_cells() const
 {
     return current_grid.get_alive_cells();
 }
@@ -252,7 +293,7 @@ unsigned int World::get_alive_cells() const
  * @return
  *      The number of dead cells.
  */
-unsigned int World::get_dead_cells() const
+std::uint64_t World::get_dead_cells() const
 {
     return current_grid.get_dead_cells();
 }
@@ -286,6 +327,290 @@ const Grid &World::get_state() const
     return current_grid;
 }
 
+/**
+ * World::get_live_box()
+ *
+ * Gets the tight bounding box of the alive cells of the current state.
+ * The box is maintained as World::step writes each generation, so this is O(1) after a step.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Make a world and print where its alive cells are
+ *      World world(Zoo::glider());
+ *      BoundingBox box = world.get_live_box();
+ *      std::cout << box.x0 << "," << box.y0 << " to " << box.x1 << "," << box.y1 << std::endl;
+ *
+ * @return
+ *      The smallest box holding every alive cell, or an empty box at 0,0 if no cells are alive.
+ */
+BoundingBox World::get_live_box() const
+{
+    return current_grid.get_live_box();
+}
+
+/**
+ * World::get_zobrist_hash()
+ *
+ * Gets the Zobrist hash of the current state, see Grid::get_zobrist_hash.
+ * With tracking on World::step updates the hash as it writes each alive cell, so this is O(1)
+ * after a step and a repeated state can be spotted by remembering the hashes seen so far.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Stop once the world falls into a cycle
+ *      World world(Zoo::glider());
+ *      world.set_zobrist_tracking(true);
+ *      std::unordered_set<std::uint64_t> seen;
+ *      while (seen.insert(world.get_zobrist_hash()).second)
+ *          world.step(true);
+ *
+ * @return
+ *      The Zobrist hash of the alive cells.
+ */
+std::uint64_t World::get_zobrist_hash() const
+{
+    return current_grid.get_zobrist_hash();
+}
+
+/**
+ * World::set_zobrist_tracking(enabled)
+ *
+ * Sets whether both state grids update their Zobrist hash on every cell flip.
+ *
+ * @param enabled
+ *      True to maintain the hash incrementally through each step.
+ */
+void World::set_zobrist_tracking(const bool enabled)
+{
+    current_grid.set_zobrist_tracking(enabled);
+    next_grid.set_zobrist_tracking(enabled);
+}
+
+/**
+ * World::get_engine()
+ *
+ * Gets the engine World::step uses to compute each generation.
+ *
+ * @return
+ *      The step engine.
+ */
+StepEngine World::get_engine() const
+{
+    return engine;
+}
+
+/**
+ * World::set_engine(engine)
+ *
+ * Sets the engine World::step uses to compute each generation. Every engine produces exactly the
+ * same cells in both toroidal and bounded modes, they only differ in speed.
+ *
+ * @example
+ *
+ *      // Step a large world with the 2x2 block lookup table
+ *      World world(2048);
+ *      world.set_engine(StepEngine::TABLE);
+ *      world.advance(100);
+ *
+ * @param engine
+ *      The step engine.
+ */
+void World::set_engine(const StepEngine engine)
+{
+    this->engine = engine;
+}
+
+/**
+ * World::get_kernel()
+ *
+ * Gets the kernel StepEngine::VECTOR steps whole words with, by default the widest one the CPU supports.
+ *
+ * @return
+ *      The vector kernel.
+ */
+Kernel World::get_kernel() const
+{
+    return kernel;
+}
+
+/**
+ * World::set_kernel(kernel)
+ *
+ * Sets the kernel StepEngine::VECTOR steps whole words with, for comparing kernels on one host.
+ *
+ * @param kernel
+ *      The vector kernel.
+ *
+ * @throws
+ *      std::invalid_argument if the kernel is not supported on this host.
+ */
+void World::set_kernel(const Kernel kernel)
+{
+    if (!StepKernels::is_supported(kernel))
+    {
+        throw std::invalid_argument(std::string(StepKernels::get_name(kernel)) + " kernel not supported on this host.");
+    }
+    this->kernel = kernel;
+}
+
+/**
+ * World::get_engine_name()
+ *
+ * Gets a name for the way World::step computes each generation, including the kernel the vector
+ * engine picked, so programs can report what they are running on.
+ *
+ * @example
+ *
+ *      // Prints "vector (avx512)" on a host with AVX-512
+ *      World world(1024);
+ *      world.set_engine(StepEngine::VECTOR);
+ *      std::cout << world.get_engine_name() << std::endl;
+ *
+ * @return
+ *      "count", "table", "bitsliced", or "vector" followed by the kernel name in brackets.
+ */
+std::string World::get_engine_name() const
+{
+    switch (engine)
+    {
+    case StepEngine::COUNT:
+        return "count";
+    case StepEngine::TABLE:
+        return "table";
+    case StepEngine::BITSLICED:
+        return "bitsliced";
+    default:
+        return std::string("vector (") + StepKernels::get_name(kernel) + ")";
+    }
+}
+
+/**
+ * World::get_rule()
+ *
+ * Gets the Life-like rule World::step applies, B3/S23 unless set otherwise.
+ *
+ * @return
+ *      A reference to the rule.
+ */
+const Rule &World::get_rule() const
+{
+    return rule;
+}
+
+/**
+ * World::set_rule(rule)
+ *
+ * Sets the Life-like rule World::step applies. Every engine runs every rule and gives the same cells,
+ * the bitsliced and vector engines using kernels compiled for the rule when it is one of the common
+ * rules, see StepKernels::is_specialized. The table engine builds the rule's table on its next step.
+ * All tiles are stepped on the next step, as the cells that were settled under the old rule may not be.
+ *
+ * @example
+ *
+ *      // Run HighLife until its replicator has copied itself a few times
+ *      World world(256);
+ *      world.set_rule(Rule("B36/S23"));
+ *      world.advance(200);
+ *
+ * @param rule
+ *      The rule to apply.
+ *
+ * @throws
+ *      std::invalid_argument if the rule has B0, which would bring the dead cells past the edges
+ *      of a bounded world to life and every empty tile along with them.
+ */
+void World::set_rule(const Rule &rule)
+{
+    if (rule.get_birth() & 1)
+    {
+        throw std::invalid_argument("rule " + rule.to_string() + " with B0 is not supported.");
+    }
+    if (rule != this->rule)
+    {
+        this->rule = rule;
+        block_table.reset();
+        tiles_valid = false;
+    }
+}
+
+/**
+ * World::get_threads()
+ *
+ * Gets the number of threads World::step computes each generation on.
+ *
+ * @return
+ *      The number of threads, 1 when stepping serially.
+ */
+unsigned int World::get_threads() const
+{
+    return threads;
+}
+
+/**
+ * World::set_threads(threads)
+ *
+ * Sets the number of threads World::step computes each generation on. The threads are started here
+ * and kept for every step, copies of the world share them. Results are the same on any number of threads.
+ *
+ * @example
+ *
+ *      // Step a large world on every hardware thread
+ *      World world(8192);
+ *      world.set_engine(StepEngine::VECTOR);
+ *      world.set_threads(0);
+ *      world.advance(100);
+ *
+ * @param threads
+ *      The number of threads, 0 for one per hardware thread.
+ */
+void World::set_threads(const unsigned int threads)
+{
+    const unsigned int count = (threads == 0) ? ThreadPool::get_hardware_threads() : threads;
+    if (count == this->threads)
+    {
+        return;
+    }
+    pool = (count > 1) ? std::make_shared<ThreadPool>(count) : nullptr;
+    this->threads = count;
+}
+
+/**
+ * World::get_thread_stats()
+ *
+ * Gets how many tiles each thread has stepped, how many it stole from other threads,
+ * and how long it was busy, since the threads were set or the stats were reset.
+ *
+ * @example
+ *
+ *      // Print the share of each step every thread spent working
+ *      for (const ThreadStats &stats : world.get_thread_stats())
+ *      {
+ *          std::cout << 100.0 * stats.busy_ns / stats.batch_ns << "%" << std::endl;
+ *      }
+ *
+ * @return
+ *      The stats of each thread, empty when stepping on one thread.
+ */
+std::vector<ThreadStats> World::get_thread_stats() const
+{
+    return pool ? pool->get_stats() : std::vector<ThreadStats>();
+}
+
+/**
+ * World::reset_thread_stats()
+ *
+ * Sets the counts returned by World::get_thread_stats back to 0.
+ */
+void World::reset_thread_stats()
+{
+    if (pool)
+    {
+        pool->reset_stats();
+    }
+}
+
 /**
  * World::resize(square_size)
  *
@@ -307,7 +632,7 @@ const Grid &World::get_state() const
  */
 void World::resize(const unsigned square_size)
 {
-    current_grid.resize(square_size,square_size);
+    resize(square_size, square_size);
 }
 
 /**
@@ -317,6 +642,7 @@ void World::resize(const unsigned square_size)
  *
  * The content of the current state grid should be preserved within the kept region.
  * The values in the next state grid do not need to be preserved, allowing an easy optimization.
+ * Both grids keep their buffers and resize in place when they are big enough, see Grid::resize.
  *
  * @example
  *
@@ -335,8 +661,206 @@ void World::resize(const unsigned square_size)
 void World::resize(const unsigned int width, const unsigned int height)
 {
     current_grid.resize(width, height);
+    //step writes the next state unchecked so it must always match the current size,
+    //its cells are overwritten by the next step so empty it first to skip moving them
+    next_grid.resize(0, 0);
+    next_grid.resize(width, height);
+    tiles_valid = false;
+}
+
+/**
+ * World::grow(left, top, right, bottom)
+ *
+ * Grow the world by adding dead cells on any of its edges, for patterns that expand.
+ *
+ * The content of the current state grid is preserved and moves right by left cells and down by top cells,
+ * see Grid::grow. Both grids grow in place when their buffers are big enough, and otherwise reallocate
+ * geometrically. The next state grid is emptied rather than moved as its values do not need to be preserved.
+ *
+ * @example
+ *
+ *      // Make a world
+ *      World world(4, 4);
+ *
+ *      // Add a 1 cell border all the way around, making it 6x6
+ *      world.grow(1, 1, 1, 1);
+ *
+ * @param left
+ *      The number of columns to add on the left edge.
+ *
+ * @param top
+ *      The number of rows to add on the top edge.
+ *
+ * @param right
+ *      The number of columns to add on the right edge.
+ *
+ * @param bottom
+ *      The number of rows to add on the bottom edge.
+ */
+void World::grow(const unsigned int left, const unsigned int top, const unsigned int right, const unsigned int bottom)
+{
+    current_grid.grow(left, top, right, bottom);
+    next_grid.resize(0, 0);
+    next_grid.resize(current_grid.get_width(), current_grid.get_height());
+    tiles_valid = false;
+    //the grids swap every step, so the world keeps the origin rather than either grid
+    origin_x -= left;
+    origin_y -= top;
+}
+
+/**
+ * World::get_unbounded()
+ *
+ * Gets whether the world is an unbounded plane, see World::set_unbounded.
+ *
+ * @return
+ *      True if the world grows as its alive cells approach an edge.
+ */
+bool World::get_unbounded() const
+{
+    return unbounded;
+}
+
+/**
+ * World::set_unbounded(unbounded)
+ *
+ * Sets whether the world is an unbounded plane. An unbounded world grows before each step on any side
+ * its alive cells could reach past, so patterns such as glider guns keep every glider they emit.
+ * When the alive cells only cover a small part of it the world is cut back around them, so a lone
+ * spaceship keeps a plane the size of its neighbourhood rather than of the path it has travelled.
+ * It has no edges to wrap, so the toroidal argument of World::step and World::advance is ignored.
+ * Turning the world unbounded also clears the capped flag, see World::get_capped.
+ *
+ * @example
+ *
+ *      // Follow a glider across a plane that starts the size of the glider
+ *      World world(Zoo::glider());
+ *      world.set_unbounded(true);
+ *      world.advance(1000);
+ *      std::cout << world.get_origin_x() << "," << world.get_origin_y() << std::endl;
+ *
+ * @param unbounded
+ *      If true the world grows as needed, if false it keeps its size.
+ */
+void World::set_unbounded(const bool unbounded)
+{
+    this->unbounded = unbounded;
+    capped = false;
+}
+
+/**
+ * World::get_origin_x()
+ *
+ * Gets the plane x coordinate of column 0 of the world. It starts at 0 and goes down by the number
+ * of columns added each time the world grows on its left edge, so cells keep their plane coordinates.
+ *
+ * @return
+ *      The x coordinate of the left edge of the world.
+ */
+int World::get_origin_x() const
+{
+    return origin_x;
+}
+
+/**
+ * World::get_origin_y()
+ *
+ * Gets the plane y coordinate of row 0 of the world. It starts at 0 and goes down by the number
+ * of rows added each time the world grows on its top edge, so cells keep their plane coordinates.
+ *
+ * @return
+ *      The y coordinate of the top edge of the world.
+ */
+int World::get_origin_y() const
+{
+    return origin_y;
+}
+
+/**
+ * get_plane_bytes(width, height)
+ *
+ * Helper function to estimate the memory used by the two grids of a world of the given size,
+ * each with a 1 cell halo and rows padded to whole cache lines with a guard as in Grid.
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ *
+ * @return
+ *      The memory of both grids in bytes.
+ */
+static std::size_t get_plane_bytes(const std::uint64_t width, const std::uint64_t height)
+{
+    const std::uint64_t alignment = GridArena::ALIGNMENT_WORDS;
+    const std::uint64_t words = alignment + (width + 1 + 63) / 64;
+    const std::uint64_t stride = (words + alignment - 1) / alignment * alignment;
+    return std::size_t(2 * (height + 2) * stride * sizeof(std::uint64_t));
+}
+
+/**
+ * World::get_memory_bytes()
+ *
+ * Gets the memory used by the current and next state grids, the figure compared with the memory cap.
+ *
+ * @return
+ *      The memory used in bytes.
+ */
+std::size_t World::get_memory_bytes() const
+{
+    return get_plane_bytes(get_width(), get_height());
+}
+
+/**
+ * World::get_memory_cap()
+ *
+ * Gets the memory an unbounded world may grow to.
+ *
+ * @return
+ *      The memory cap in bytes, 1 GiB by default.
+ */
+std::size_t World::get_memory_cap() const
+{
+    return memory_cap;
+}
+
+/**
+ * World::set_memory_cap(bytes)
+ *
+ * Sets the memory an unbounded world may grow to and clears the capped flag. A world already over
+ * the cap keeps its size, it just stops growing.
+ *
+ * @example
+ *
+ *      // Keep a plane under 64 MiB
+ *      world.set_memory_cap(std::size_t(64) << 20);
+ *
+ * @param bytes
+ *      The memory cap in bytes.
+ */
+void World::set_memory_cap(const std::size_t bytes)
+{
+    memory_cap = bytes;
+    capped = false;
+}
+
+/**
+ * World::get_capped()
+ *
+ * Gets whether an unbounded world has needed to grow past its memory cap since it was made unbounded
+ * or the cap was last set. A capped world keeps stepping with dead cells past the edges it could not
+ * grow, so alive cells reaching those edges may have been lost.
+ *
+ * @return
+ *      True if a growth was refused.
+ */
+bool World::get_capped() const
+{
+    return capped;
 }
 
+
 /**
  * World::count_neighbours(x, y, toroidal)
  *
@@ -352,6 +876,9 @@ void World::resize(const unsigned int width, const unsigned int height)
  *
  * If toroidal = true then correctly wrap out of bounds coordinates to the opposite side of the grid.
  *
+ * Both cases read the halo of the current state grid, which must have been refreshed for the same
+ * value of toroidal by Grid::refresh_halo. Only a torus 1 cell wide or high wraps coordinates by hand.
+ *
  * This function is in World and not Grid because the 3x3 sized neighbourhood is specific to Conway's Game of Life,
  * while Grid is more generic to any 2D grid based cellular automaton.
  *
@@ -369,66 +896,572 @@ void World::resize(const unsigned int width, const unsigned int height)
  *      Returns the number of alive neighbours.
  */
 
-unsigned int World::count_neighbours(const int x, const int y, const bool toroidal)
+unsigned int World::count_neighbours(const int x, const int y, const bool toroidal) const
 {
+    const int width = current_grid.get_width();
+    const int height = current_grid.get_height();
     unsigned int neighbours = 0;
-    int new_j = 0;
-    int new_i = 0;
 
-    for (int i = y - 1; i <= y + 1; i++)
+    if (!toroidal || (width >= 2 && height >= 2))
     {
-        for (int j = x - 1; j <= x + 1; j++)
+        //the halo holds dead or wrapped copies of the edges so read the 3x3 square branch-free
+        for (int i = y - 1; i <= y + 1; i++)
         {
-            new_j = j;
-            new_i = i;
-
-            if (toroidal == true)
+            for (int j = x - 1; j <= x + 1; j++)
             {
-                //if width is too small
-                if (j == -1)
-                {
-                    new_j = current_grid.get_width() + j;
-                }
-                //if height is too small
-                if (i == -1)
-                {
-                    new_i = current_grid.get_height() + i;
-                }
-                //if width is too big
-                if (j == current_grid.get_width())
-                {
-                    new_j = 0;
-                }
-                //if height is too big
-                if (i == current_grid.get_height())
+                neighbours += (current_grid.get_unchecked(j, i) == Cell::ALIVE);
+            }
+        }
+        //a cell is not its own neighbour
+        return neighbours - (current_grid.get_unchecked(x, y) == Cell::ALIVE);
+    }
+
+    //a torus 1 cell wide or high wraps neighbours back onto the cell itself,
+    //so fall back to wrapping each coordinate and skipping the cell
+
+    for (int i = y - 1; i <= y + 1; i++)
+    {
+        int new_i = i;
+        //wrap or skip rows off the top and bottom edges
+        if (i == -1 || i == height)
+        {
+            if (!toroidal)
+            {
+                continue;
+            }
+            new_i = (i == -1) ? height - 1 : 0;
+        }
+
+        for (int j = x - 1; j <= x + 1; j++)
+        {
+            int new_j = j;
+            //wrap or skip columns off the left and right edges
+            if (j == -1 || j == width)
+            {
+                if (!toroidal)
+                {
+                    continue;
+                }
+                new_j = (j == -1) ? width - 1 : 0;
+            }
+
+            //coordinates are in bounds now so skip the checked get,
+            //if its not itself and is alive then increment
+            if (!((new_i == y) && (new_j == x)) && current_grid.get_unchecked(new_j, new_i) == Cell::ALIVE)
+            {
+                neighbours++;
+            }
+        }
+    }
+    return neighbours;
+}
+
+/**
+ * build_step_table(rule)
+ *
+ * Helper function to precompute the next state under a rule of every 2x2 block of cells from its 4x4 neighbourhood.
+ * Bits 4r to 4r + 3 of an index hold row r of the neighbourhood, from the column left of the block
+ * to the column right of it, and bit 2r + c of an entry is the cell at row r and column c of the block.
+ *
+ * @return
+ *      The table of 65536 entries.
+ */
+static std::vector<unsigned char> build_step_table(const Rule &rule)
+{
+    std::vector<unsigned char> table(1 << 16);
+    for (unsigned int index = 0; index < table.size(); index++)
+    {
+        for (unsigned int r = 0; r < 2; r++)
+        {
+            for (unsigned int c = 0; c < 2; c++)
+            {
+                //the cell sits at row r + 1 and column c + 1 of the neighbourhood
+                unsigned int neighbours = 0;
+                for (unsigned int i = r; i <= r + 2; i++)
                 {
-                    new_i = 0;
+                    for (unsigned int j = c; j <= c + 2; j++)
+                    {
+                        neighbours += (index >> (4 * i + j)) & 1;
+                    }
                 }
-                //if its not itself and is alive then increment
-                if (!((new_i == y) && (new_j == x)) && current_grid.get(new_j, new_i) == Cell::ALIVE)
+                const bool alive = (index >> (4 * (r + 1) + c + 1)) & 1;
+                neighbours -= alive;
+                if (rule.get_next(alive, neighbours))
                 {
-                    neighbours++;
+                    table[index] |= 1 << (2 * r + c);
                 }
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * get_step_table(rule)
+ *
+ * Helper function to get the 2x2 block table of a rule. Every world running B3/S23 shares one table,
+ * built the first time it is needed, other rules build their own.
+ *
+ * @return
+ *      The 65536 entries of the table.
+ */
+static std::shared_ptr<const std::vector<unsigned char>> get_step_table(const Rule &rule)
+{
+    static const std::shared_ptr<const std::vector<unsigned char>> conway =
+        std::make_shared<const std::vector<unsigned char>>(build_step_table(Rule()));
+    return rule.is_conway() ? conway : std::make_shared<const std::vector<unsigned char>>(build_step_table(rule));
+}
+
+/**
+ * tile_rows, tile_columns
+ *
+ * The size of the tiles the cells are split into for tracking activity and stepping on several threads.
+ * Rows come in pairs for the table engine, and columns in whole words so tiles never share a word.
+ */
+static const int tile_rows = 32;
+static const int tile_columns = 512;
+
+/**
+ * max_run_tiles
+ *
+ * The most active tiles side by side that are stepped as one region, so dense rows of tiles
+ * are stepped in long runs of words while still tracking each tile on its own.
+ */
+static const unsigned int max_run_tiles = 4;
+
+/**
+ * temporal_block_depth
+ *
+ * The most generations World::advance computes in each band of rows before writing it back.
+ * Each band recomputes this many rows above and below it every block, so deeper blocks save more
+ * memory traffic but repeat more work.
+ */
+static const unsigned int temporal_block_depth = 8;
+
+/**
+ * temporal_block_bytes
+ *
+ * The size the two scratch buffers of a band aim for, small enough to stay in a core's L2 cache.
+ */
+static const std::size_t temporal_block_bytes = std::size_t(1) << 18;
+
+/**
+ * temporal_block_min_words
+ *
+ * The smallest grid, in words, that World::advance blocks. Smaller grids already stay in cache
+ * between generations, so they are stepped one generation at a time with the active tiles.
+ */
+static const std::size_t temporal_block_min_words = std::size_t(1) << 17;
+
+/**
+ * plane_min_growth
+ *
+ * The fewest cells an unbounded world grows by on a side that needs to grow, one word of columns.
+ */
+static const std::uint64_t plane_min_growth = 64;
+
+/**
+ * plane_shrink_ratio
+ *
+ * How many times bigger than the live box with its room to grow an unbounded world can get before
+ * it is cut back to fit. Growth at most doubles a side, so a steadily spreading pattern never shrinks.
+ */
+static const std::uint64_t plane_shrink_ratio = 4;
+
+/**
+ * fill_row_halo(row, width, toroidal)
+ *
+ * Helper function to set the edge of a scratch row of a temporally blocked band, laid out as a guard word,
+ * the words of the cells from bit 0 of word 1, and a word past the right halo cell. Bits past the width
+ * are cleared, then the guard bit left of cell 0 and the halo bit right of the last cell are filled with
+ * dead or wrapped cells, as Grid::refresh_halo does for a whole grid.
+ */
+static void fill_row_halo(std::uint64_t *row, const int width, const bool toroidal)
+{
+    const unsigned int words = (width + 63) / 64;
+    if (width % 64 != 0)
+    {
+        row[words] &= (std::uint64_t(1) << (width % 64)) - 1;
+    }
+    row[0] = 0;
+    row[words + 1] = 0;
+    if (toroidal)
+    {
+        row[0] = ((row[1 + (width - 1) / 64] >> ((width - 1) % 64)) & 1) << 63;
+        row[1 + width / 64] |= (row[1] & 1) << (width % 64);
+    }
+}
+
+/**
+ * World::get_current_row(y)
+ *
+ * Private helper function to read a row of packed words of the current state, for the step engines.
+ * It always goes through the const Grid::get_row, as the non-const one hands out a writable row and so
+ * marks the alive cell count, live box, and Zobrist hash of the grid as needing a full recount.
+ *
+ * @param y
+ *      The row, from -1 to the height for the halo rows.
+ *
+ * @return
+ *      A pointer to the first word of the row.
+ */
+const std::uint64_t *World::get_current_row(const int y) const
+{
+    //a const member, so this is always the const overload
+    return current_grid.get_row(y);
+}
+
+/**
+ * World::write_row(region, y, words, delta)
+ *
+ * Private helper function to write the words of row y that cover a region into the next state grid,
+ * keeping only the cells inside the region and collecting the changes in a delta.
+ * The row is compared with the same cells of the current state, flagging each tile that changes.
+ *
+ * @param region
+ *      The cells being computed.
+ *
+ * @param y
+ *      The row to write.
+ *
+ * @param words
+ *      The row of next state words, indexed from cell 0 of the row.
+ *
+ * @param delta
+ *      The delta to add the changes to.
+ *
+ * @param changed
+ *      The flags of the tiles covered by the region, from the tile holding region.x0,
+ *      set to 1 for every tile with a cell in the row that changes.
+ */
+void World::write_row(const BoundingBox &region, const int y, std::uint64_t *words, GridDelta &delta,
+                      unsigned char *changed)
+{
+    const std::uint64_t *row = get_current_row(y);
+    const unsigned int first_word = region.x0 / 64;
+    const unsigned int last_word = (region.x1 - 1) / 64;
+    const std::uint64_t first_mask = ~std::uint64_t(0) << (region.x0 % 64);
+    const std::uint64_t last_mask = (region.x1 % 64 != 0) ? (std::uint64_t(1) << (region.x1 % 64)) - 1
+                                                          : ~std::uint64_t(0);
+    words[first_word] &= first_mask;
+    words[last_word] &= last_mask;
+    const unsigned int tile_words = tile_columns / 64;
+    std::uint64_t differences = 0;
+    for (unsigned int i = first_word; i <= last_word; i++)
+    {
+        //the current row holds halo bits outside the region, so mask them off the comparison too
+        const std::uint64_t cells = ((i == first_word) ? first_mask : ~std::uint64_t(0))
+                                    & ((i == last_word) ? last_mask : ~std::uint64_t(0));
+        differences |= (words[i] ^ row[i]) & cells;
+        //flag each tile once all of its words are compared, rather than branching on every word
+        if (i % tile_words == tile_words - 1 || i == last_word)
+        {
+            changed[i / tile_words - first_word / tile_words] |= (differences != 0);
+            differences = 0;
+        }
+    }
+    next_grid.set_words_unchecked(first_word * 64, y, words + first_word, last_word - first_word + 1, delta);
+}
+
+/**
+ * World::step_count(region, toroidal, words, delta)
+ *
+ * Private helper function to write the next state of the cells in a region of the current state
+ * grid into the next state grid, counting the neighbours of each cell with World::count_neighbours.
+ *
+ * @param region
+ *      The cells to compute, all other cells are dead in the next state.
+ *
+ * @param toroidal
+ *      If true then the step will consider the grid as a torus.
+ *
+ * @param words
+ *      Scratch space for a row of next state words.
+ *
+ * @param delta
+ *      The delta to add the changes to the next state grid to.
+ *
+ * @param changed
+ *      The flags of the tiles covered by the region, set to 1 for every tile with a cell that changes.
+ */
+void World::step_count(const BoundingBox &region, const bool toroidal, std::vector<std::uint64_t> &words,
+                       GridDelta &delta, unsigned char *changed)
+{
+    const unsigned int first_word = region.x0 / 64;
+    const unsigned int last_word = (region.x1 - 1) / 64;
+    words.resize(last_word + 1);
+    for (int y = region.y0; y < region.y1; y++)
+    {
+        std::fill(words.begin() + first_word, words.end(), 0);
+        for (int x = region.x0; x < region.x1; x++)
+        {
+            //get the neighbours 
+            int num_neighbours = count_neighbours(x, y, toroidal);
+            //the rule says if it is alive next, for B3/S23 if its 2 and alive, or if its 3,
+            //otherwise leave it dead
+            if (rule.get_next(current_grid.get_unchecked(x, y) == Cell::ALIVE, num_neighbours))
+            {
+                words[x / 64] |= std::uint64_t(1) << (x % 64);
+            }
+        }
+        write_row(region, y, words.data(), delta, changed);
+    }
+}
 
-                //if not toroidal
+/**
+ * World::step_table(region, words, delta)
+ *
+ * Private helper function to write the next state of the cells in a region of the current state
+ * grid into the next state grid, a 2x2 block at a time from the precomputed block table.
+ *
+ * Each pair of rows reads a 64 bit window from each of the 4 rows around it, starting one column
+ * left of the blocks, so one set of reads covers the neighbourhoods of 31 blocks (62 cells).
+ * The halo of the current state grid must already be refreshed, so this covers the toroidal and
+ * bounded modes alike, except on a torus 1 cell wide or high which World::step_count handles.
+ *
+ * @param region
+ *      The cells to compute, all other cells are dead in the next state.
+ *
+ * @param words
+ *      Scratch space for a pair of rows of next state words.
+ *
+ * @param delta
+ *      The delta to add the changes to the next state grid to.
+ *
+ * @param changed
+ *      The flags of the tiles covered by the region, set to 1 for every tile with a cell that changes.
+ */
+void World::step_table(const BoundingBox &region, std::vector<std::uint64_t> &words, GridDelta &delta,
+                       unsigned char *changed)
+{
+    const unsigned char *table = block_table->data();
+    const int width = get_width();
+    const int height = get_height();
+    const unsigned int first_word = region.x0 / 64;
+    const unsigned int row_words = (region.x1 - 1) / 64 + 1;
+    words.resize(2 * row_words);
+    std::uint64_t *next[2] = {words.data(), words.data() + row_words};
+    for (int y = region.y0; y < region.y1; y += 2)
+    {
+        //halo rows cover y - 1 and y + 1, past the bottom halo only a discarded cell needs row y + 2
+        const std::uint64_t *rows[4] = {get_current_row(y - 1), get_current_row(y), get_current_row(y + 1),
+                                        get_current_row(std::min(y + 2, height))};
+        std::fill(next[0] + first_word, next[0] + row_words, 0);
+        std::fill(next[1] + first_word, next[1] + row_words, 0);
+        for (int x = region.x0; x < region.x1; x += 62)
+        {
+            //read columns x - 1 up to x + 62, stopping at the right halo column
+            const unsigned int count = std::min(x + 62, width) - x + 2;
+            std::uint64_t window[4];
+            for (unsigned int r = 0; r < 4; r++)
+            {
+                window[r] = read_bits(rows[r] - 1, 63 + x, count);
             }
-            else
+
+            for (int b = 0; b < 31 && x + 2 * b < region.x1; b++)
             {
-                //if its out of bounds and not toroidal
-                if ((j == -1) || (i == -1) || (j == current_grid.get_width()) || (i == current_grid.get_height()))
+                const unsigned int index = ((window[0] >> (2 * b)) & 15) | (((window[1] >> (2 * b)) & 15) << 4)
+                                           | (((window[2] >> (2 * b)) & 15) << 8) | (((window[3] >> (2 * b)) & 15) << 12);
+                const unsigned int block = table[index];
+                if (block == 0)
                 {
-                    new_j = x;
-                    new_i = y;
+                    continue;
                 }
-                //if its not itself and is alive
-                if ((!((new_i == y) && (new_j == x)) && (current_grid.get(new_j, new_i) == Cell::ALIVE)))
+                //collect the alive cells of the block that fall inside the region
+                for (unsigned int i = 0; i < 4; i++)
                 {
-                    neighbours++;
+                    const int cell_x = x + 2 * b + (i & 1);
+                    if (((block >> i) & 1) && cell_x < region.x1)
+                    {
+                        next[i >> 1][cell_x / 64] |= std::uint64_t(1) << (cell_x % 64);
+                    }
                 }
             }
         }
+        write_row(region, y, next[0], delta, changed);
+        if (y + 1 < region.y1)
+        {
+            write_row(region, y + 1, next[1], delta, changed);
+        }
+    }
+}
+
+/**
+ * World::step_bitsliced(region, kernel, words, delta)
+ *
+ * Private helper function to write the next state of the cells in a region of the current state
+ * grid into the next state grid, a whole row of words at a time with a bitsliced row kernel.
+ *
+ * The left neighbour of cell 0 comes from the guard word before each row, and the right neighbour of
+ * the last cell from the right halo, so once the halo is refreshed this covers the toroidal and bounded
+ * modes alike, except on a torus 1 cell wide or high which World::step_count handles.
+ * A partial last word has no readable word to its right, so it is stepped on its own.
+ *
+ * @param region
+ *      The cells to compute, all other cells are dead in the next state.
+ *
+ * @param kernel
+ *      The kernel to step whole words with.
+ *
+ * @param words
+ *      Scratch space for a row of next state words.
+ *
+ * @param delta
+ *      The delta to add the changes to the next state grid to.
+ *
+ * @param changed
+ *      The flags of the tiles covered by the region, set to 1 for every tile with a cell that changes.
+ */
+void World::step_bitsliced(const BoundingBox &region, const Kernel kernel, std::vector<std::uint64_t> &words,
+                           GridDelta &delta, unsigned char *changed)
+{
+    const int width = get_width();
+    const unsigned int first_word = region.x0 / 64;
+    const unsigned int last_word = (region.x1 - 1) / 64;
+    //words past the last whole word have their right neighbours past the width
+    const unsigned int whole_words = std::min<unsigned int>(last_word + 1, width / 64);
+    const StepKernels::RowKernel step_row = StepKernels::get_row_kernel(kernel, rule);
+    words.resize(last_word + 1);
+    for (int y = region.y0; y < region.y1; y++)
+    {
+        const std::uint64_t *above = get_current_row(y - 1);
+        const std::uint64_t *row = get_current_row(y);
+        const std::uint64_t *below = get_current_row(y + 1);
+        if (whole_words > first_word)
+        {
+            step_row(above + first_word, row + first_word, below + first_word,
+                     words.data() + first_word, whole_words - first_word, rule);
+        }
+        if (last_word >= whole_words)
+        {
+            words[last_word] = StepKernels::step_word(above + last_word, row + last_word, below + last_word, false, rule);
+        }
+        //only the cells inside the region are written, the whole run in one go
+        write_row(region, y, words.data(), delta, changed);
+    }
+}
+
+/**
+ * World::find_active_tiles(toroidal)
+ *
+ * Private helper function to list the tiles the next step has to compute, as runs of up to
+ * max_run_tiles active tiles side by side.
+ *
+ * The cells of a tile next generation depend only on the tile and the cells around it, so a tile
+ * that did not change last generation, with no neighbouring tile that changed either, stays the same.
+ * The next state grid still holds the generation before the current one, so it already has the right
+ * cells for those tiles and they are skipped. Every other tile is active.
+ * Only the tiles of the last runs can have changed, so finding them costs time proportional to the
+ * tiles that were active rather than to the whole world, and their changed flags are cleared as they are read.
+ *
+ * Without a previous step to compare with (after construction, a resize, or switching between toroidal
+ * and bounded steps) the next state grid is cleared, and the tiles covering the live bounding box plus
+ * a margin of one cell are active, as cells further out can only be dead next generation.
+ *
+ * @param toroidal
+ *      If true then the step will consider the grid as a torus, so tiles on opposite edges are neighbours.
+ */
+void World::find_active_tiles(const bool toroidal)
+{
+    const int width = get_width();
+    const int height = get_height();
+    const int columns = (width + tile_columns - 1) / tile_columns;
+    const int rows = (height + tile_rows - 1) / tile_rows;
+    active_tiles.clear();
+    if (!tiles_valid || toroidal != tiles_toroidal)
+    {
+        //only the live box and a margin of one cell around it can change
+        const BoundingBox live = current_grid.get_live_box();
+        int x0 = live.x0 - 1;
+        int y0 = live.y0 - 1;
+        int x1 = live.x1 + 1;
+        int y1 = live.y1 + 1;
+        if (live.x0 == live.x1 || live.y0 == live.y1)
+        {
+            x0 = x1 = y0 = y1 = 0;
+        }
+        //on a torus a margin over the edge wraps to the other side, so take the whole width or height
+        if (toroidal && (x0 < 0 || x1 > width))
+        {
+            x0 = 0;
+            x1 = width;
+        }
+        if (toroidal && (y0 < 0 || y1 > height))
+        {
+            y0 = 0;
+            y1 = height;
+        }
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, width);
+        y1 = std::min(y1, height);
+
+        next_grid.clear();
+        tile_active.assign(columns * rows, 0);
+        tile_changed.assign(columns * rows, 0);
+        for (int row = y0 / tile_rows; x0 < x1 && y0 < y1 && row <= (y1 - 1) / tile_rows; row++)
+        {
+            for (int column = x0 / tile_columns; column <= (x1 - 1) / tile_columns; column++)
+            {
+                active_tiles.push_back(row * columns + column);
+            }
+        }
+        tiles_valid = true;
+        tiles_toroidal = toroidal;
+    }
+    else
+    {
+        //a tile is active if it or any of its 8 neighbouring tiles changed last generation
+        for (const TileRun run : active_runs)
+        {
+            for (unsigned int tile = run.tile; tile < run.tile + run.count; tile++)
+            {
+                if (!tile_changed[tile])
+                {
+                    continue;
+                }
+                tile_changed[tile] = 0;
+                const int row = tile / columns;
+                const int column = tile % columns;
+                for (int i = row - 1; i <= row + 1; i++)
+                {
+                    for (int j = column - 1; j <= column + 1; j++)
+                    {
+                        //wrap tiles off the edges on a torus, skip them otherwise
+                        const int wrapped_i = (i + rows) % rows;
+                        const int wrapped_j = (j + columns) % columns;
+                        const unsigned int neighbour = wrapped_i * columns + wrapped_j;
+                        if ((toroidal || (i == wrapped_i && j == wrapped_j)) && !tile_active[neighbour])
+                        {
+                            tile_active[neighbour] = 1;
+                            active_tiles.push_back(neighbour);
+                        }
+                    }
+                }
+            }
+        }
+        //the flags are left clear for the next step, the list holds the tiles
+        for (const unsigned int tile : active_tiles)
+        {
+            tile_active[tile] = 0;
+        }
+        std::sort(active_tiles.begin(), active_tiles.end());
+    }
+
+    active_runs.clear();
+    for (const unsigned int tile : active_tiles)
+    {
+        //extend the run of the previous tile while it is in the same row and has room
+        const TileRun *last = active_runs.empty() ? nullptr : &active_runs.back();
+        if (last != nullptr && tile % columns > 0 && last->tile + last->count == tile && last->count < max_run_tiles)
+        {
+            active_runs.back().count++;
+        }
+        else
+        {
+            active_runs.push_back(TileRun{tile, 1});
+        }
     }
-    return neighbours;
 }
 
 /**
@@ -437,15 +1470,28 @@ unsigned int World::count_neighbours(const int x, const int y, const bool toroid
  * Take one step in Conway's Game of Life.
  *
  * Reads from the current state grid and writes to the next state grid. Then swaps the grids.
- * Should be implemented by invoking World::count_neighbours(x, y, toroidal).
+ * The next state is computed by the engine chosen with World::set_engine, which all give the same result.
  * Swapping the grids should be done in O(1) constant time, and should not invoke a copy.
  * Try and boil the logic down to the fewest and most simple conditional statements.
  *
+ * The grid is split into tiles of tile_rows by tile_columns cells, and only the tiles that changed
+ * last generation and their neighbours are computed, see World::find_active_tiles. The other tiles
+ * are left as they are in the next state grid, which already holds their cells. Worlds where most
+ * cells are dead or still life step in time proportional to the tiles that are still changing.
+ *
+ * Active tiles side by side are stepped together in runs of up to max_run_tiles tiles. With more than
+ * one thread the runs are run on the World's ThreadPool. Threads that run out of runs steal them from
+ * threads that are still busy, so a few dense tiles do not hold up the rest.
+ * The grids are only swapped once every tile is done.
+ *
+ * An unbounded world first grows on any side its alive cells are next to, see World::set_unbounded.
+ *
  * Rules: https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
  *      - Any live cell with fewer than two live neighbours dies, as if by underpopulation.
  *      - Any live cell with two or three live neighbours lives on to the next generation.
  *      - Any live cell with more than three live neighbours dies, as if by overpopulation.
  *      - Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
+ * These are B3/S23, the default rule, World::set_rule picks another.
  *
  * @param toroidal
  *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
@@ -453,24 +1499,80 @@ unsigned int World::count_neighbours(const int x, const int y, const bool toroid
  */
 void World::step(const bool toroidal)
 {
-    for (int y = 0; y < get_height(); y++)
+    //an unbounded plane first grows so no alive cell can reach past an edge, then steps as a bounded world
+    if (unbounded)
+    {
+        expand_plane(1);
+    }
+    const bool wrap = toroidal && !unbounded;
+    const int width = get_width();
+    const int height = get_height();
+    const int columns = (width + tile_columns - 1) / tile_columns;
+    //fill the halo so count_neighbours never has to check the edges. Stepping never writes the halo,
+    //so a bounded world only clears the halos of both grids when the tiles start afresh, and a torus
+    //then only copies the halo cells next to the active runs
+    const bool refresh = !tiles_valid || wrap != tiles_toroidal;
+    if (refresh)
+    {
+        current_grid.refresh_halo(wrap);
+        next_grid.refresh_halo(wrap);
+    }
+    find_active_tiles(wrap);
+    const auto get_region = [&](const TileRun run)
     {
-        for (int x = 0; x < get_width(); x++)
+        const int x0 = (run.tile % columns) * tile_columns;
+        const int y0 = (run.tile / columns) * tile_rows;
+        return BoundingBox{x0, y0, std::min(width, x0 + int(run.count) * tile_columns), std::min(height, y0 + tile_rows)};
+    };
+    for (unsigned int task = 0; wrap && !refresh && task < active_runs.size(); task++)
+    {
+        current_grid.refresh_halo(true, get_region(active_runs[task]));
+    }
+
+    //a torus 1 cell wide or high wraps neighbours onto the cell itself, which only counting handles
+    const bool count = engine == StepEngine::COUNT || (wrap && (width < 2 || height < 2));
+    //the table of the rule is built before the runs start, so they only ever read it
+    if (engine == StepEngine::TABLE && !block_table)
+    {
+        block_table = get_step_table(rule);
+    }
+    thread_words.resize(threads);
+    run_deltas.assign(active_runs.size(), GridDelta{});
+    const ThreadPool::Work step_run = [&](const unsigned int task, const unsigned int thread)
+    {
+        const TileRun run = active_runs[task];
+        const BoundingBox region = get_region(run);
+        //each run flags only its own tiles
+        unsigned char *changed = tile_changed.data() + run.tile;
+        if (count)
         {
-            //get the neighbours 
-            int num_neighbours = count_neighbours(x, y, toroidal);
-            //if its 2 and alive, or if its 3 then its alive
-            if ((num_neighbours == 2 && current_grid.get(x, y) == Cell::ALIVE) || num_neighbours == 3)
-            {
-                next_grid.set(x, y, Cell::ALIVE);
-            }
-            else
-            //otherwise its <2 or >4 so set dead
-            {
-                next_grid.set(x, y, Cell::DEAD);
-            }
+            step_count(region, wrap, thread_words[thread], run_deltas[task], changed);
+        }
+        else if (engine == StepEngine::TABLE)
+        {
+            step_table(region, thread_words[thread], run_deltas[task], changed);
+        }
+        else
+        {
+            step_bitsliced(region, (engine == StepEngine::VECTOR) ? kernel : Kernel::SCALAR,
+                           thread_words[thread], run_deltas[task], changed);
+        }
+    };
+    if (pool)
+    {
+        pool->run(active_runs.size(), step_run);
+    }
+    else
+    {
+        for (unsigned int task = 0; task < active_runs.size(); task++)
+        {
+            step_run(task, 0);
         }
     }
+    for (const GridDelta &delta : run_deltas)
+    {
+        next_grid.merge_delta(delta);
+    }
     //swap grids
     std::swap(current_grid,next_grid);
 }
@@ -478,8 +1580,14 @@ void World::step(const bool toroidal)
 /**
  * World::advance(steps, toroidal)
  *
- * Advance multiple steps in the Game of Life.
- * Should be implemented by invoking World::step(toroidal).
+ * Advance multiple steps in the Game of Life, giving exactly the same cells as calling World::step(toroidal)
+ * that many times.
+ *
+ * Grids too large to stay in cache, with live cells over at least half their area, are advanced with the
+ * bitsliced and vector engines a block of up to temporal_block_depth generations at a time by
+ * World::advance_blocked, which reads and writes the grids once per block rather than once per generation.
+ * Everything else, and any single generation left over, is stepped with World::step.
+ * An unbounded world grows before each block by as many cells as the block has generations.
  *
  * @param steps
  *      The number of steps to advance the world forward.
@@ -491,8 +1599,222 @@ void World::step(const bool toroidal)
 
 void World::advance(const unsigned int steps, const bool toroidal)
 {
-    for (unsigned int i = 0; i < steps; i++)
+    const bool wrap = toroidal && !unbounded;
+    unsigned int i = 0;
+    while (i + 1 < steps)
+    {
+        //blocking pays off only when the cells no longer fit in cache and most of them are live
+        const BoundingBox live = get_live_box();
+        const bool bitsliced = engine == StepEngine::BITSLICED || engine == StepEngine::VECTOR;
+        const bool busy = 2 * std::uint64_t(live.x1 - live.x0) * (live.y1 - live.y0) >= get_total_cells();
+        const bool large = std::size_t(current_grid.get_stride()) * get_height() >= temporal_block_min_words;
+        const bool wraps = !wrap || (get_width() >= 2 && get_height() >= 2);
+        if (!(bitsliced && busy && large && wraps))
+        {
+            break;
+        }
+        //a plane grows enough for the whole block, after which its edges stay dead as in a bounded world
+        const unsigned int depth = std::min(steps - i, temporal_block_depth);
+        if (unbounded)
+        {
+            expand_plane(depth);
+        }
+        advance_blocked(depth, wrap);
+        i += depth;
+    }
+    for (; i < steps; i++)
     {
         step(toroidal);
     }
 }
+
+/**
+ * World::advance_blocked(depth, toroidal)
+ *
+ * Private helper function to advance the world by several generations with a bitsliced engine,
+ * reading and writing each cell of the grids only once.
+ *
+ * The rows are split into bands sized so the scratch rows of a band stay in cache. Each band copies its
+ * rows and depth rows either side into a scratch buffer, then steps the scratch rows depth times between
+ * two buffers. Every generation the rows nearest the top and bottom lose a neighbour they would need,
+ * so the rows computed shrink by one at each end, leaving exactly the band's rows after depth generations.
+ * These are written into the next state grid and the grids are swapped as in World::step.
+ *
+ * Rows above and below a bounded grid stay dead, while on a torus they are copied from the opposite
+ * edge, which gives the torus exactly for any band size. The left and right halo bits of every scratch
+ * row are refilled each generation. Bands are independent, so they run on the World's ThreadPool.
+ *
+ * The next state grid no longer holds the generation before the current one, so the active tiles
+ * are found afresh on the next call to World::step.
+ *
+ * @param depth
+ *      The number of generations to advance, at least 1.
+ *
+ * @param toroidal
+ *      If true then the steps will consider the grid as a torus. A torus must be at least 2 cells wide and high.
+ */
+void World::advance_blocked(const unsigned int depth, const bool toroidal)
+{
+    const int width = get_width();
+    const int height = get_height();
+    const unsigned int words = (width + 63) / 64;
+    const unsigned int stride = words + 2;
+    //each band aims to fill its scratch buffers, but always keeps a few times as many rows as it repeats
+    const std::size_t fit_rows = temporal_block_bytes / (2 * sizeof(std::uint64_t) * stride);
+    const int band_rows = int(std::max<std::size_t>(fit_rows, 6 * depth) - 2 * depth);
+    const unsigned int bands = (height + band_rows - 1) / band_rows;
+    const StepKernels::RowKernel step_row =
+        StepKernels::get_row_kernel((engine == StepEngine::VECTOR) ? kernel : Kernel::SCALAR, rule);
+
+    thread_words.resize(threads);
+    run_deltas.assign(bands, GridDelta{});
+    const ThreadPool::Work step_band = [&](const unsigned int task, const unsigned int thread)
+    {
+        //scratch row r holds grid row y0 - depth + r
+        const int y0 = task * band_rows;
+        const int y1 = std::min(height, y0 + band_rows);
+        const int rows = y1 - y0 + 2 * depth;
+        std::vector<std::uint64_t> &scratch = thread_words[thread];
+        scratch.assign(2 * std::size_t(rows) * stride, 0);
+        std::uint64_t *buffers[2] = {scratch.data(), scratch.data() + std::size_t(rows) * stride};
+
+        bool any_alive = false;
+        for (int r = 0; r < rows; r++)
+        {
+            const int y = y0 - int(depth) + r;
+            if (!toroidal && (y < 0 || y >= height))
+            {
+                continue;
+            }
+            std::uint64_t *row = buffers[0] + std::size_t(r) * stride;
+            const std::uint64_t *source = get_current_row((y % height + height) % height);
+            std::copy(source, source + words, row + 1);
+            fill_row_halo(row, width, toroidal);
+            for (unsigned int i = 1; i <= words; i++)
+            {
+                any_alive = any_alive || row[i] != 0;
+            }
+        }
+
+        //a band with nothing alive within reach stays dead, so only the zeroed rows are written
+        unsigned int current = 0;
+        for (unsigned int generation = 1; any_alive && generation <= depth; generation++)
+        {
+            const std::uint64_t *from = buffers[current];
+            std::uint64_t *to = buffers[1 - current];
+            //rows outside a bounded grid are never computed, so they stay dead in both buffers
+            const int first = toroidal ? int(generation) : std::max<int>(generation, depth - y0);
+            const int last = toroidal ? rows - int(generation) : std::min<int>(rows - generation, height - y0 + depth);
+            for (int r = first; r < last; r++)
+            {
+                const std::size_t offset = std::size_t(r) * stride + 1;
+                step_row(from + offset - stride, from + offset, from + offset + stride, to + offset, words, rule);
+                fill_row_halo(to + offset - 1, width, toroidal);
+            }
+            current = 1 - current;
+        }
+
+        for (int y = y0; y < y1; y++)
+        {
+            //the wrapped halo bit past the last cell is not a cell, so it must be cleared before writing
+            std::uint64_t *row = buffers[current] + std::size_t(y - y0 + depth) * stride;
+            fill_row_halo(row, width, false);
+            next_grid.set_words_unchecked(0, y, row + 1, words, run_deltas[task]);
+        }
+    };
+    if (pool)
+    {
+        pool->run(bands, step_band);
+    }
+    else
+    {
+        for (unsigned int task = 0; task < bands; task++)
+        {
+            step_band(task, 0);
+        }
+    }
+    for (const GridDelta &delta : run_deltas)
+    {
+        next_grid.merge_delta(delta);
+    }
+    std::swap(current_grid, next_grid);
+    tiles_valid = false;
+}
+
+/**
+ * World::expand_plane(margin)
+ *
+ * Private helper function to grow an unbounded world so that at least margin dead columns and rows
+ * separate its alive cells from every edge, enough for margin generations to stay inside the world.
+ *
+ * The room a pattern gets to grow into is the larger of margin, plane_min_growth, and half its width
+ * or height on each side. A world more than plane_shrink_ratio times the area of the live box with that
+ * room is first cut back to exactly that, centred on the live box, and the origin moves with it.
+ *
+ * Each side that is too close grows by the larger of what it needs, plane_min_growth, and half the
+ * width or height, so a pattern spreading steadily grows the world a logarithmic number of times.
+ * If that would pass the memory cap only the cells needed are added, and if even that would pass it
+ * the world does not grow and is flagged as capped.
+ *
+ * @param margin
+ *      The number of dead cells needed between the alive cells and each edge.
+ */
+void World::expand_plane(const unsigned int margin)
+{
+    const BoundingBox live = get_live_box();
+    if (live.x0 == live.x1 || live.y0 == live.y1)
+    {
+        return;
+    }
+    const std::uint64_t live_width = live.x1 - live.x0;
+    const std::uint64_t live_height = live.y1 - live.y0;
+    const std::uint64_t room_x = std::max({std::uint64_t(margin), plane_min_growth, live_width / 2});
+    const std::uint64_t room_y = std::max({std::uint64_t(margin), plane_min_growth, live_height / 2});
+    const std::uint64_t fit_width = live_width + 2 * room_x;
+    const std::uint64_t fit_height = live_height + 2 * room_y;
+    if (std::uint64_t(get_width()) * get_height() > plane_shrink_ratio * fit_width * fit_height)
+    {
+        //copy the live box into a grid that fits it, the next state is overwritten so only needs the size
+        Grid fitted(fit_width, fit_height, 1);
+        fitted.set_zobrist_tracking(current_grid.get_zobrist_tracking());
+        fitted.merge(current_grid.view(live.x0, live.y0, live.x1, live.y1), room_x, room_y);
+        current_grid = std::move(fitted);
+        next_grid.resize(0, 0);
+        next_grid.resize(fit_width, fit_height);
+        tiles_valid = false;
+        origin_x += live.x0 - int(room_x);
+        origin_y += live.y0 - int(room_y);
+        return;
+    }
+
+    const std::uint64_t width = get_width();
+    const std::uint64_t height = get_height();
+    const std::uint64_t need[4] = {std::uint64_t(std::max<int>(0, int(margin) - live.x0)),
+                                   std::uint64_t(std::max<int>(0, int(margin) - live.y0)),
+                                   std::uint64_t(std::max<std::int64_t>(0, live.x1 + std::int64_t(margin) - width)),
+                                   std::uint64_t(std::max<std::int64_t>(0, live.y1 + std::int64_t(margin) - height))};
+    if (need[0] == 0 && need[1] == 0 && need[2] == 0 && need[3] == 0)
+    {
+        return;
+    }
+
+    std::uint64_t add[4];
+    for (unsigned int side = 0; side < 4; side++)
+    {
+        const std::uint64_t half = ((side % 2 == 0) ? width : height) / 2;
+        add[side] = need[side] ? std::max({need[side], plane_min_growth, half}) : 0;
+    }
+    const std::uint64_t limit = std::numeric_limits<int>::max();
+    const std::uint64_t *const attempts[2] = {add, need};
+    for (const std::uint64_t *grow_by : attempts)
+    {
+        const std::uint64_t new_width = width + grow_by[0] + grow_by[2];
+        const std::uint64_t new_height = height + grow_by[1] + grow_by[3];
+        if (new_width <= limit && new_height <= limit && get_plane_bytes(new_width, new_height) <= memory_cap)
+        {
+            grow(grow_by[0], grow_by[1], grow_by[2], grow_by[3]);
+            return;
+        }
+    }
+    capped = true;
+}
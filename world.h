@@ -13,7 +13,30 @@
 
 // Add the minimal number of includes you need in order to declare the class.
 // #include ...
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
 #include "grid.h"
+#include "rule.h"
+#include "step_kernels.h"
+#include "thread_pool.h"
+
+/**
+ * A StepEngine selects how World::step computes the next generation, all engines give the same cells.
+ *      - StepEngine::COUNT counts the neighbours of each cell one at a time.
+ *      - StepEngine::TABLE looks up the next state of each 2x2 block of cells from its 4x4 neighbourhood.
+ *      - StepEngine::BITSLICED computes 64 cells at once from their packed words with bitwise adders.
+ *      - StepEngine::VECTOR runs the bitsliced adders on whole vectors with the World's Kernel.
+ */
+enum class StepEngine : char
+{
+    COUNT,
+    TABLE,
+    BITSLICED,
+    VECTOR
+};
+
 /**
  * Declare the structure of the World class for representing a 2d grid world.
  *
@@ -23,9 +46,47 @@
 class World
 {
 private:
+    //a run of active tiles side by side in one row of tiles, stepped as a single region
+    struct TileRun
+    {
+        unsigned int tile;
+        unsigned int count;
+    };
+
     Grid current_grid;
     Grid next_grid;
-    unsigned int count_neighbours(const int x, const int y, const bool toroidal);
+    StepEngine engine;
+    Kernel kernel;
+    Rule rule;
+    std::shared_ptr<const std::vector<unsigned char>> block_table;
+    unsigned int threads;
+    std::shared_ptr<ThreadPool> pool;
+    std::vector<std::vector<std::uint64_t>> thread_words;
+    std::vector<GridDelta> run_deltas;
+    std::vector<unsigned char> tile_changed;
+    std::vector<unsigned char> tile_active;
+    std::vector<unsigned int> active_tiles;
+    std::vector<TileRun> active_runs;
+    bool tiles_valid;
+    bool tiles_toroidal;
+    bool unbounded;
+    bool capped;
+    std::size_t memory_cap;
+    int origin_x;
+    int origin_y;
+    unsigned int count_neighbours(const int x, const int y, const bool toroidal) const;
+    const std::uint64_t *get_current_row(const int y) const;
+    void find_active_tiles(const bool toroidal);
+    void write_row(const BoundingBox &region, const int y, std::uint64_t *words, GridDelta &delta,
+                   unsigned char *changed);
+    void step_count(const BoundingBox &region, const bool toroidal, std::vector<std::uint64_t> &words,
+                    GridDelta &delta, unsigned char *changed);
+    void step_table(const BoundingBox &region, std::vector<std::uint64_t> &words, GridDelta &delta,
+                    unsigned char *changed);
+    void step_bitsliced(const BoundingBox &region, const Kernel kernel, std::vector<std::uint64_t> &words,
+                        GridDelta &delta, unsigned char *changed);
+    void advance_blocked(const unsigned int depth, const bool toroidal);
+    void expand_plane(const unsigned int margin);
 
 public:
     World();
@@ -36,14 +97,40 @@ public:
 
     int get_width() const;
     int get_height() const;
-    unsigned int get_total_cells() const;
-    unsigned int get_alive_cells() const;
-    unsigned int get_dead_cells() const;
+    std::uint64_t get_total_cells() const;
+    std::uint64_t get_alive_cells() const;
+    std::uint64_t get_dead_cells() const;
 
     const Grid &get_state() const;
+    BoundingBox get_live_box() const;
+    std::uint64_t get_zobrist_hash() const;
+    void set_zobrist_tracking(const bool enabled);
+
+    StepEngine get_engine() const;
+    void set_engine(const StepEngine engine);
+    Kernel get_kernel() const;
+    void set_kernel(const Kernel kernel);
+    std::string get_engine_name() const;
+    const Rule &get_rule() const;
+    void set_rule(const Rule &rule);
+
+    unsigned int get_threads() const;
+    void set_threads(const unsigned int threads);
+    std::vector<ThreadStats> get_thread_stats() const;
+    void reset_thread_stats();
 
     void resize(const unsigned int square_size);
     void resize(const unsigned int new_width, const unsigned int new_height);
+    void grow(const unsigned int left, const unsigned int top, const unsigned int right, const unsigned int bottom);
+
+    bool get_unbounded() const;
+    void set_unbounded(const bool unbounded);
+    int get_origin_x() const;
+    int get_origin_y() const;
+    std::size_t get_memory_bytes() const;
+    std::size_t get_memory_cap() const;
+    void set_memory_cap(const std::size_t bytes);
+    bool get_capped() const;
 
     void step(const bool toroidal = false);
     
@@ -4,6 +4,7 @@
  *          - These creatures are drawn on a Grid the size of their bounding box.
  *
  *      - Grids can be loaded from and saved to an ascii file format.
+ *          - Savers take a GridView, so saving a Grid or part of one never copies it.
  *          - Ascii files are composed of:
  *              - A header line containing an integer width and height separated by a space.
  *              - followed by (height) number of lines, each containing (width) number of characters,
@@ -30,6 +31,7 @@
 #include <fstream>
 #include <iostream>
 #include <bitset>
+#include <vector>
 #include <math.h>
 #include <stdexcept>
 
@@ -203,11 +205,11 @@ Grid Zoo::load_ascii(const std::string path)
                         //set the cell to dead or alive depending on ascii character
                         if (line.substr(x, 1) == "#")
                         {
-                            ascii_grid.set(x, y, Cell::ALIVE);
+                            ascii_grid.set_unchecked(x, y, Cell::ALIVE);
                         }
                         else if (line.substr(x, 1) == " ")
                         {
-                            ascii_grid.set(x, y, Cell::DEAD);
+                            ascii_grid.set_unchecked(x, y, Cell::DEAD);
                         }
                         else
                         {
@@ -245,12 +247,13 @@ Grid Zoo::load_ascii(const std::string path)
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid to be written out to file. Taken as a GridView so a Grid, World::get_state(),
+ *      or a window made by Grid::view are all saved without being copied.
  *
  * @throws
  *      Throws std::runtime_error or sub-class if the file cannot be opened.
  */
-void Zoo::save_ascii(const std::string path, const Grid grid)
+void Zoo::save_ascii(const std::string path, const GridView &grid)
 {
     std::ofstream outputFile(path, std::ofstream::out);
     if (!outputFile)
@@ -269,7 +272,7 @@ void Zoo::save_ascii(const std::string path, const Grid grid)
             for (int x = 0; x < grid.get_width(); x++)
             {
                 //if its alive add a # to file otherwise add a space
-                if (grid.get(x, y) == Cell::ALIVE)
+                if (grid.get_unchecked(x, y) == Cell::ALIVE)
                 {
                     outputFile << '#';
                 }
@@ -284,6 +287,33 @@ void Zoo::save_ascii(const std::string path, const Grid grid)
     }
 }
 
+/**
+ * Zoo::save_ascii(path, grid)
+ *
+ * Save a grid as Zoo::save_ascii(path, view). A tiled grid cannot be viewed, so it is converted to a
+ * row major copy first.
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid to be written out to file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ */
+void Zoo::save_ascii(const std::string path, const Grid &grid)
+{
+    if (grid.get_layout() == Layout::TILED)
+    {
+        save_ascii(path, GridView(grid.to_layout(Layout::ROW_MAJOR)));
+    }
+    else
+    {
+        save_ascii(path, GridView(grid));
+    }
+}
+
 /**
  * Zoo::load_binary(path)
  *
@@ -373,7 +403,7 @@ Grid Zoo::load_binary(const std::string path)
         {
             for (int x = 0; x < binary_grid.get_width(); x++)
             {
-                binary_grid.set(x, y, cells.at(x + width * y));
+                binary_grid.set_unchecked(x, y, cells.at(x + width * y));
             }
         }
 
@@ -405,12 +435,13 @@ Grid Zoo::load_binary(const std::string path)
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid to be written out to file. Taken as a GridView so a Grid, World::get_state(),
+ *      or a window made by Grid::view are all saved without being copied.
  *
  * @throws
  *      Throws std::runtime_error or sub-class if the file cannot be opened.
  */
-void Zoo::save_binary(const std::string path, Grid grid)
+void Zoo::save_binary(const std::string path, const GridView &grid)
 {
 
     std::ofstream outputFile(path);
@@ -432,7 +463,7 @@ void Zoo::save_binary(const std::string path, Grid grid)
         {
             for (int x = 0; x < grid.get_width(); x++)
             {
-                if (grid.get(x, y) == Cell::ALIVE)
+                if (grid.get_unchecked(x, y) == Cell::ALIVE)
                 {
                     bits.set(counter, 1);
                 }
@@ -474,3 +505,30 @@ void Zoo::save_binary(const std::string path, Grid grid)
         }
     }
 }
+
+/**
+ * Zoo::save_binary(path, grid)
+ *
+ * Save a grid as Zoo::save_binary(path, view). A tiled grid cannot be viewed, so it is converted to a
+ * row major copy first.
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid to be written out to file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ */
+void Zoo::save_binary(const std::string path, const Grid &grid)
+{
+    if (grid.get_layout() == Layout::TILED)
+    {
+        save_binary(path, GridView(grid.to_layout(Layout::ROW_MAJOR)));
+    }
+    else
+    {
+        save_binary(path, GridView(grid));
+    }
+}
@@ -24,10 +24,12 @@ Grid r_pentomino();
 Grid light_weight_spaceship();
 
 Grid load_ascii(const std::string path);
-void save_ascii(const std::string path, const Grid grid);
+void save_ascii(const std::string path, const GridView &grid);
+void save_ascii(const std::string path, const Grid &grid);
 
 Grid load_binary(const std::string path);
-void save_binary(const std::string path, const Grid grid);
+void save_binary(const std::string path, const GridView &grid);
+void save_binary(const std::string path, const Grid &grid);
 
 // How to draw an owl:
 //      Step 1. Draw a circle.